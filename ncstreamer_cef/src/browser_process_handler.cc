@@ -36,6 +36,8 @@ BrowserProcessHandler::BrowserProcessHandler(
       remote_port_{cmd_line.remote_port()},
       location_{cmd_line.location()},
       uid_hash_{cmd_line.uid_hash()},
+      obs_backend_{cmd_line.obs_backend()},
+      start_latency_log_{cmd_line.start_latency_log()},
       client_{} {
 }
 
@@ -68,7 +70,9 @@ void BrowserProcessHandler::OnContextInitialized() {
       device_settings_,
       remote_port_,
       location_,
-      uid_hash_};
+      uid_hash_,
+      obs_backend_,
+      start_latency_log_};
 
   std::wstring uri{ui_uri_};
   if (uri.empty() == true) {
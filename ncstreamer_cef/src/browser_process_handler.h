@@ -51,6 +51,8 @@ class BrowserProcessHandler : public CefBrowserProcessHandler {
   const uint16_t remote_port_;
   const std::wstring location_;
   const std::wstring uid_hash_;
+  const std::wstring obs_backend_;
+  const std::wstring start_latency_log_;
 
   CefRefPtr<Client> client_;
 
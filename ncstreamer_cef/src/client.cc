@@ -25,6 +25,7 @@
 #include "ncstreamer_cef/src/obs.h"
 #include "ncstreamer_cef/src/obs/obs_source_info.h"
 #include "ncstreamer_cef/src/render_process_message_types.h"
+#include "ncstreamer_cef/src/start_latency_recorder.h"
 
 
 namespace ncstreamer {
@@ -40,12 +41,16 @@ Client::Client(
     const boost::property_tree::ptree &device_settings,
     const uint16_t &remote_port,
     const std::wstring &location,
-    const std::wstring &uid_hash)
+    const std::wstring &uid_hash,
+    const std::wstring &obs_backend,
+    const std::wstring &start_latency_log)
     : locale_{locale},
       tag_ids_{tag_ids},
       designated_user_{designated_user},
       remote_port_{remote_port},
       location_{location},
+      obs_backend_{obs_backend},
+      start_latency_log_{start_latency_log},
       display_handler_{new ClientDisplayHandler{}},
       life_span_handler_{new ClientLifeSpanHandler{instance}},
       load_handler_{new ClientLoadHandler{life_span_handler_,
@@ -130,7 +135,8 @@ bool Client::OnRenderProcessEvent(
 
 
 void Client::InitializeService(const OnInitialized on_initialized) {
-  ncstreamer::Obs::SetUp();
+  ncstreamer::StartLatencyRecorder::SetUp(start_latency_log_);
+  ncstreamer::Obs::SetUp(ncstreamer::ObsBackend::Create(obs_backend_));
   ncstreamer::StreamingService::SetUp(tag_ids_);
   ncstreamer::DesignatedUser::SetUp(designated_user_);
   ncstreamer::RemoteServer::SetUp(GetMainBrowser());
@@ -143,6 +149,7 @@ void Client::ShutdownService() {
   ncstreamer::RemoteServer::ShutDown();
   ncstreamer::StreamingService::ShutDown();
   ncstreamer::Obs::ShutDown();
+  ncstreamer::StartLatencyRecorder::ShutDown();
 }
 
 
@@ -209,6 +216,11 @@ void Client::OnCommand(const std::string &cmd,
            std::placeholders::_1,
            std::placeholders::_2,
            std::placeholders::_3)},
+      {"streaming/stats",
+       std::bind(&This::OnCommandStreamingStats, this,
+           std::placeholders::_1,
+           std::placeholders::_2,
+           std::placeholders::_3)},
       {"settings/mic/search",
        std::bind(&This::OnCommandSettingsMicSearch, this,
            std::placeholders::_1,
@@ -229,6 +241,26 @@ void Client::OnCommand(const std::string &cmd,
            std::placeholders::_1,
            std::placeholders::_2,
            std::placeholders::_3)},
+      {"settings/desktop/volume/update",
+       std::bind(&This::OnCommandSettingsDesktopVolumeUpdate, this,
+           std::placeholders::_1,
+           std::placeholders::_2,
+           std::placeholders::_3)},
+      {"settings/mic/filters/update",
+       std::bind(&This::OnCommandSettingsMicFiltersUpdate, this,
+           std::placeholders::_1,
+           std::placeholders::_2,
+           std::placeholders::_3)},
+      {"settings/audio/format/update",
+       std::bind(&This::OnCommandSettingsAudioFormatUpdate, this,
+           std::placeholders::_1,
+           std::placeholders::_2,
+           std::placeholders::_3)},
+      {"settings/audio/quality/update",
+       std::bind(&This::OnCommandSettingsAudioQualityUpdate, this,
+           std::placeholders::_1,
+           std::placeholders::_2,
+           std::placeholders::_3)},
       {"settings/webcam/search",
        std::bind(&This::OnCommandSettingsWebcamSearch, this,
            std::placeholders::_1,
@@ -279,6 +311,11 @@ void Client::OnCommand(const std::string &cmd,
            std::placeholders::_1,
            std::placeholders::_2,
            std::placeholders::_3)},
+      {"settings/stream_delay/update",
+       std::bind(&This::OnCommandSettingsStreamDelayUpdate, this,
+           std::placeholders::_1,
+           std::placeholders::_2,
+           std::placeholders::_3)},
       {"storage/user_page/update",
        std::bind(&This::OnCommandStorageUserPageUpdate, this,
            std::placeholders::_1,
@@ -401,6 +438,14 @@ void Client::OnCommandServiceProviderLogIn(
     }
 
     std::vector<boost::property_tree::ptree> tree_servers;
+    if (stream_servers.size() > 1) {
+      const StreamingServiceProvider::StreamServer auto_server{
+          StreamingService::kAutoStreamServer,
+          "Auto",
+          StreamingService::kAutoStreamServer,
+          "1"};
+      tree_servers.emplace_back(auto_server.ToTree());
+    }
     for (const auto &server : stream_servers) {
       tree_servers.emplace_back(server.ToTree());
     }
@@ -501,6 +546,7 @@ void Client::OnCommandStreamingStart(
 
   LocalStorage::Get()->SetDescription(description);
   ObsSourceInfo source_info{source};
+  StartLatencyRecorder::Get()->Begin();
   StreamingService::Get()->PostLiveVideo(
       stream_server,
       user_page,
@@ -509,6 +555,7 @@ void Client::OnCommandStreamingStart(
       description,
       source_info.title(),
       [browser, cmd](const std::string &error) {
+    StartLatencyRecorder::Get()->Finish(error);
     JsExecutor::Execute(browser, "cef.onResponse", cmd,
         JsExecutor::StringPairVector{{"error", error}});
   }, [browser, cmd, source](const std::string &service_provider,
@@ -516,10 +563,13 @@ void Client::OnCommandStreamingStart(
                             const std::string &stream_key,
                             const std::string &video_id,
                             const std::string &post_url) {
+    StartLatencyRecorder::Get()->Mark(
+        StartLatencyRecorder::Stage::kLiveVideoPosted);
     bool result = Obs::Get()->StartStreaming(
         source,
         service_provider,
         stream_server,
+        StreamingService::Get()->GetFallbackServers(stream_server),
         stream_key,
         [browser,
          cmd,
@@ -528,6 +578,9 @@ void Client::OnCommandStreamingStart(
          stream_key,
          video_id,
          post_url]() {
+      StartLatencyRecorder::Get()->Mark(
+          StartLatencyRecorder::Stage::kOutputStarted);
+      StartLatencyRecorder::Get()->Finish("");
       JsExecutor::Execute(browser, "cef.onResponse", cmd,
           JsExecutor::StringPairVector{
               {"error", ""},
@@ -535,11 +588,22 @@ void Client::OnCommandStreamingStart(
               {"streamUrl", stream_server + stream_key},
               {"videoId", video_id},
               {"postUrl", post_url}});
-    }, [browser, cmd]() {
+    }, [browser, cmd](ObsOutput::StopReason /*reason*/) {
+      StartLatencyRecorder::Get()->Finish("obs timeout");
       JsExecutor::Execute(browser, "cef.onResponse", cmd,
           JsExecutor::StringPairVector{{"error", "obs timeout"}});
+    }, [](int attempt,
+          const std::chrono::milliseconds &delay,
+          const std::string &stream_server) {
+      RemoteServer::Get()->NotifyStreamingReconnect(
+          attempt, delay.count(), stream_server);
+    }, [](int attempts, const std::string &stream_server) {
+      RemoteServer::Get()->NotifyStreamingRecovered(attempts, stream_server);
+    }, [](StartLatencyRecorder::Stage stage) {
+      StartLatencyRecorder::Get()->Mark(stage);
     });
     if (result == false) {
+      StartLatencyRecorder::Get()->Finish("obs internal");
       JsExecutor::Execute(browser, "cef.onResponse", cmd,
           JsExecutor::StringPairVector{{"error", "obs internal"}});
     }
@@ -553,17 +617,53 @@ void Client::OnCommandStreamingStop(
     CefRefPtr<CefBrowser> browser) {
   StreamingService::Get()->StopLiveVideo();
 
-  Obs::Get()->StopStreaming([browser, cmd]() {
+  Obs::Get()->StopStreaming([browser, cmd](ObsOutput::StopReason reason) {
+    static const std::unordered_map<ObsOutput::StopReason, std::string>
+        kReasons{{ObsOutput::StopReason::kUser, "user"},
+                 {ObsOutput::StopReason::kNetwork, "network"},
+                 {ObsOutput::StopReason::kTimeout, "timeout"},
+                 {ObsOutput::StopReason::kRemote, "remote"}};
     JsExecutor::Execute(browser, "cef.onResponse", cmd,
-        JsExecutor::StringPairVector{{"error", ""}});
+        JsExecutor::StringPairVector{
+            {"error", ""},
+            {"reason", kReasons.at(reason)}});
   });
 }
 
 
+void Client::OnCommandStreamingStats(
+    const std::string &cmd,
+    const CommandArgumentMap &args,
+    CefRefPtr<CefBrowser> browser) {
+  std::size_t count{ObsStatsSampler::kMaxSamples};
+  auto count_i = args.find("count");
+  if (count_i != args.end()) {
+    try {
+      count = std::stoul(count_i->second);
+    } catch (...) {
+    }
+  }
+
+  boost::property_tree::ptree arg;
+  arg.add("error", "");
+  arg.add_child("stats", ObsStatsSampler::ToPtree(
+      Obs::Get()->GetStreamingStats(count)));
+
+  JsExecutor::Execute(browser, "cef.onResponse", cmd, arg);
+}
+
+
 void Client::OnCommandSettingsMicSearch(
       const std::string &cmd,
       const CommandArgumentMap &args,
       CefRefPtr<CefBrowser> browser) {
+  // the UI thread must not wait for libobs to start up.
+  if (Obs::Get()->IsReady() == false) {
+    JsExecutor::Execute(browser, "cef.onResponse", cmd,
+        JsExecutor::StringPairVector{{"error", "not ready"}});
+    return;
+  }
+
   std::unordered_map<std::string /*id*/, std::string /*name*/>
       mic_devices = Obs::Get()->SearchMicDevices();
 
@@ -668,10 +768,132 @@ void Client::OnCommandSettingsMicVolumeUpdate(
 }
 
 
+void Client::OnCommandSettingsDesktopVolumeUpdate(
+    const std::string &cmd,
+    const CommandArgumentMap &args,
+    CefRefPtr<CefBrowser> browser) {
+  auto volume_i = args.find("volume");
+  if (volume_i == args.end()) {
+    assert(false);
+    return;
+  }
+
+  float volume{0.0};
+  try {
+    volume = std::stof(volume_i->second);
+  } catch (...) {
+    assert(false);
+    return;
+  }
+  std::string error{};
+  bool result = Obs::Get()->UpdateDesktopVolume(volume);
+  if (!result) {
+    error = "no desktop audio";
+  }
+  JsExecutor::Execute(browser, "cef.onResponse", cmd,
+      JsExecutor::StringPairVector{{"error", error},
+                                   {"volume", volume_i->second}});
+}
+
+
+void Client::OnCommandSettingsMicFiltersUpdate(
+    const std::string &cmd,
+    const CommandArgumentMap &args,
+    CefRefPtr<CefBrowser> browser) {
+  auto noise_gate_i = args.find("noiseGate");
+  auto noise_suppression_i = args.find("noiseSuppression");
+  if (noise_gate_i == args.end() ||
+      noise_suppression_i == args.end()) {
+    assert(false);
+    return;
+  }
+
+  Obs::Get()->UpdateMicNoiseFilters(
+      noise_gate_i->second == "true",
+      noise_suppression_i->second == "true");
+  JsExecutor::Execute(browser, "cef.onResponse", cmd,
+      JsExecutor::StringPairVector{{"error", ""}});
+}
+
+
+void Client::OnCommandSettingsAudioFormatUpdate(
+    const std::string &cmd,
+    const CommandArgumentMap &args,
+    CefRefPtr<CefBrowser> browser) {
+  static const std::unordered_map<std::string, speaker_layout> kChannels{
+      {"mono", SPEAKERS_MONO},
+      {"stereo", SPEAKERS_STEREO}};
+
+  auto sample_rate_i = args.find("sampleRate");
+  auto channels_i = args.find("channels");
+  if (sample_rate_i == args.end() ||
+      channels_i == args.end()) {
+    assert(false);
+    return;
+  }
+
+  uint32_t sample_rate{0};
+  try {
+    sample_rate = std::stoul(sample_rate_i->second);
+  } catch (...) {
+    assert(false);
+    return;
+  }
+  auto speakers_i = kChannels.find(channels_i->second);
+  if (speakers_i == kChannels.end()) {
+    assert(false);
+    return;
+  }
+
+  std::string error{};
+  bool result = Obs::Get()->UpdateAudioFormat(sample_rate, speakers_i->second);
+  if (!result) {
+    error = "audio format error";
+  }
+  JsExecutor::Execute(browser, "cef.onResponse", cmd,
+      JsExecutor::StringPairVector{{"error", error}});
+}
+
+
+void Client::OnCommandSettingsAudioQualityUpdate(
+    const std::string &cmd,
+    const CommandArgumentMap &args,
+    CefRefPtr<CefBrowser> browser) {
+  auto bitrate_i = args.find("bitrate");
+  if (bitrate_i == args.end()) {
+    assert(false);
+    return;
+  }
+
+  uint32_t bitrate{0};
+  try {
+    bitrate = std::stoul(bitrate_i->second);
+  } catch (...) {
+    assert(false);
+    return;
+  }
+
+  std::string error{};
+  bool result = Obs::Get()->UpdateAudioQuality(bitrate);
+  if (!result) {
+    error = "audio quality error";
+  }
+  JsExecutor::Execute(browser, "cef.onResponse", cmd,
+      JsExecutor::StringPairVector{{"error", error}});
+}
+
+
 void Client::OnCommandSettingsWebcamSearch(
   const std::string &cmd,
   const CommandArgumentMap &args,
   CefRefPtr<CefBrowser> browser) {
+  // the UI thread must not wait for libobs to start up.
+  if (Obs::Get()->IsReady() == false) {
+    JsExecutor::Execute(browser, "cef.onResponse", cmd,
+        JsExecutor::StringPairVector{{"error", "not ready"}});
+    return;
+  }
+
   std::vector<std::string> webcams = Obs::Get()->FindAllWebcamDevices();
 
   std::vector<boost::property_tree::ptree> tree_webcams;
@@ -932,7 +1154,7 @@ void Client::OnCommandSettingsChromaKeySimilarityUpdate(
     return;
   }
 
-  bool result = Obs::Get()->UpdateChromaKeyColor(similarity);
+  bool result = Obs::Get()->UpdateChromaKeySimilarity(similarity);
   if (!result) {
     std::string error{"failed to update chroma key similarity"};
     JsExecutor::Execute(browser, "cef.onResponse", cmd,
@@ -987,6 +1209,34 @@ void Client::OnCommandSettingsVideoQualityUpdate(
 }
 
 
+void Client::OnCommandSettingsStreamDelayUpdate(
+    const std::string &cmd,
+    const CommandArgumentMap &args,
+    CefRefPtr<CefBrowser> browser) {
+  auto delay_i = args.find("delay");
+  if (delay_i == args.end()) {
+    assert(false);
+    return;
+  }
+
+  uint32_t delay{0};
+  try {
+    delay = std::stoul(delay_i->second);
+  } catch (...) {
+    assert(false);
+    return;
+  }
+
+  const uint32_t applied_delay = Obs::Get()->UpdateStreamDelay(delay);
+  JsExecutor::Execute(browser, "cef.onResponse", cmd,
+      JsExecutor::StringPairVector{
+          {"error", ""},
+          {"delay", std::to_string(applied_delay)},
+          {"bufferSize", std::to_string(
+              Obs::Get()->GetStreamDelayBufferSize())}});
+}
+
+
 void Client::OnCommandStorageUserPageUpdate(
     const std::string &cmd,
     const CommandArgumentMap &args,
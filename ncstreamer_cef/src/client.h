@@ -38,7 +38,9 @@ class Client : public CefClient {
       const boost::property_tree::ptree &device_settings,
       const uint16_t &remote_port,
       const std::wstring &location,
-      const std::wstring &uid_hash);
+      const std::wstring &uid_hash,
+      const std::wstring &obs_backend,
+      const std::wstring &start_latency_log);
 
   virtual ~Client();
 
@@ -113,6 +115,10 @@ class Client : public CefClient {
       const std::string &cmd,
       const CommandArgumentMap &args,
       CefRefPtr<CefBrowser> browser);
+  void OnCommandStreamingStats(
+      const std::string &cmd,
+      const CommandArgumentMap &args,
+      CefRefPtr<CefBrowser> browser);
   void OnCommandSettingsMicSearch(
       const std::string &cmd,
       const CommandArgumentMap &args,
@@ -129,6 +135,22 @@ class Client : public CefClient {
       const std::string &cmd,
       const CommandArgumentMap &args,
       CefRefPtr<CefBrowser> browser);
+  void OnCommandSettingsDesktopVolumeUpdate(
+      const std::string &cmd,
+      const CommandArgumentMap &args,
+      CefRefPtr<CefBrowser> browser);
+  void OnCommandSettingsMicFiltersUpdate(
+      const std::string &cmd,
+      const CommandArgumentMap &args,
+      CefRefPtr<CefBrowser> browser);
+  void OnCommandSettingsAudioFormatUpdate(
+      const std::string &cmd,
+      const CommandArgumentMap &args,
+      CefRefPtr<CefBrowser> browser);
+  void OnCommandSettingsAudioQualityUpdate(
+      const std::string &cmd,
+      const CommandArgumentMap &args,
+      CefRefPtr<CefBrowser> browser);
   void OnCommandSettingsWebcamSearch(
       const std::string &cmd,
       const CommandArgumentMap &args,
@@ -169,6 +191,10 @@ class Client : public CefClient {
       const std::string &cmd,
       const CommandArgumentMap &args,
       CefRefPtr<CefBrowser> browser);
+  void OnCommandSettingsStreamDelayUpdate(
+      const std::string &cmd,
+      const CommandArgumentMap &args,
+      CefRefPtr<CefBrowser> browser);
   void OnCommandStorageUserPageUpdate(
       const std::string &cmd,
       const CommandArgumentMap &args,
@@ -207,6 +233,8 @@ class Client : public CefClient {
   const std::wstring designated_user_;
   const uint16_t remote_port_;
   const std::wstring location_;
+  const std::wstring obs_backend_;
+  const std::wstring start_latency_log_;
   CefRefPtr<ClientDisplayHandler> display_handler_;
   CefRefPtr<ClientLifeSpanHandler> life_span_handler_;
   CefRefPtr<ClientLoadHandler> load_handler_;
@@ -37,6 +37,7 @@ ClientLoadHandler::ClientLoadHandler(
       white_sources_{},
       device_settings_{device_setting},
       prev_sources_{},
+      prev_generation_{0},
       uid_hash_{uid_hash},
       main_page_loaded_{false} {
   assert(life_span_handler);
@@ -175,13 +176,19 @@ void ClientLoadHandler::UpdateSourcesPeriodically(
     return;
   }
 
-  const auto &all = Obs::Get()->FindAllWindowsOnDesktop();
-  const auto &sources = (shows_sources_all_ == true) ?
-      all : FilterSources(uid_hash_, all, white_sources_);
+  const uint64_t generation = Obs::Get()->GetWindowsGeneration();
+  if (generation != prev_generation_) {
+    prev_generation_ = generation;
 
-  if (sources != prev_sources_) {
-    JsExecutor::Execute(browser, "updateStreamingSources", "sources", sources);
-    prev_sources_ = sources;
+    const auto &all = Obs::Get()->FindAllWindowsOnDesktop();
+    const auto &sources = (shows_sources_all_ == true) ?
+        *all : FilterSources(uid_hash_, *all, white_sources_);
+
+    if (sources != prev_sources_) {
+      JsExecutor::Execute(
+          browser, "updateStreamingSources", "sources", sources);
+      prev_sources_ = sources;
+    }
   }
 
   ::CefPostDelayedTask(
@@ -7,6 +7,7 @@
 #define NCSTREAMER_CEF_SRC_CLIENT_CLIENT_LOAD_HANDLER_H_
 
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -69,6 +70,7 @@ class ClientLoadHandler : public CefLoadHandler {
   const boost::property_tree::ptree device_settings_;
   const std::wstring uid_hash_;
   std::vector<std::string> prev_sources_;
+  uint64_t prev_generation_;
 
   bool main_page_loaded_;
 
@@ -31,7 +31,9 @@ CommandLine::CommandLine(const std::wstring &cmd_line)
       default_position_{CW_USEDEFAULT, CW_USEDEFAULT},
       device_settings_{},
       location_{},
-      uid_hash_{} {
+      uid_hash_{},
+      obs_backend_{},
+      start_latency_log_{} {
   CefRefPtr<CefCommandLine> cef_cmd_line =
       CefCommandLine::CreateCommandLine();
   cef_cmd_line->InitFromString(cmd_line);
@@ -101,6 +103,8 @@ CommandLine::CommandLine(const std::wstring &cmd_line)
 
   location_ = cef_cmd_line->GetSwitchValue(L"location");
   uid_hash_ = cef_cmd_line->GetSwitchValue(L"uid-hash");
+  obs_backend_ = cef_cmd_line->GetSwitchValue(L"obs-backend");
+  start_latency_log_ = cef_cmd_line->GetSwitchValue(L"start-latency-log");
 }
 
 
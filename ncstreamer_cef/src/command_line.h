@@ -46,6 +46,10 @@ class CommandLine {
   }
   const std::wstring &location() const { return location_; }
   const std::wstring &uid_hash() const { return uid_hash_; }
+  const std::wstring &obs_backend() const { return obs_backend_; }
+  const std::wstring &start_latency_log() const {
+    return start_latency_log_;
+  }
 
  private:
   static bool ReadBool(
@@ -78,6 +82,8 @@ class CommandLine {
   boost::property_tree::ptree device_settings_;
   std::wstring location_;
   std::wstring uid_hash_;
+  std::wstring obs_backend_;
+  std::wstring start_latency_log_;
 };
 }  // namespace ncstreamer
 
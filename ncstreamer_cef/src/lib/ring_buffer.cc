@@ -0,0 +1,10 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/lib/ring_buffer.h"
+
+
+namespace ncstreamer {
+}  // namespace ncstreamer
@@ -0,0 +1,75 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_LIB_RING_BUFFER_H_
+#define NCSTREAMER_CEF_SRC_LIB_RING_BUFFER_H_
+
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+
+namespace ncstreamer {
+// Keeps the last N values pushed by a single writer. Neither the writer nor
+// the readers take a lock; a reader skips slots overwritten while it copied.
+// T has to be trivially copyable.
+template <typename T, std::size_t N>
+class RingBuffer {
+ public:
+  RingBuffer() : slots_{}, written_{0} {}
+
+  void Push(const T &value) {
+    const uint64_t index = written_.load(std::memory_order_relaxed);
+    Slot &slot = slots_[index % N];
+    slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.value = value;
+    slot.sequence.store(index * 2 + 2, std::memory_order_release);
+    written_.store(index + 1, std::memory_order_release);
+  }
+
+  // the latest |count| values, oldest first.
+  std::vector<T> CopyLatest(std::size_t count) const {
+    const uint64_t written = written_.load(std::memory_order_acquire);
+    const uint64_t available = std::min<uint64_t>(written, N);
+    const uint64_t first = written - std::min<uint64_t>(count, available);
+
+    std::vector<T> values;
+    values.reserve(static_cast<std::size_t>(written - first));
+    for (uint64_t index = first; index < written; ++index) {
+      const Slot &slot = slots_[index % N];
+      const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+      if (before != index * 2 + 2) {
+        continue;
+      }
+      T value = slot.value;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) != before) {
+        continue;
+      }
+      values.emplace_back(value);
+    }
+    return values;
+  }
+
+ private:
+  class Slot {
+   public:
+    Slot() : sequence{0}, value{} {}
+
+    std::atomic<uint64_t> sequence;
+    T value;
+  };
+
+  std::array<Slot, N> slots_;
+  std::atomic<uint64_t> written_;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_LIB_RING_BUFFER_H_
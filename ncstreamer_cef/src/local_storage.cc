@@ -77,6 +77,26 @@ std::string LocalStorage::GetYouTubePrivacy() const {
 }
 
 
+std::string LocalStorage::GetEncoderPreset(const std::string &mode) const {
+  boost::optional<const boost::property_tree::ptree &> presets =
+      storage_.get_child_optional(kEncoderPresets);
+  if (!presets) {
+    return "";
+  }
+  return presets->get(mode, "");
+}
+
+
+int LocalStorage::GetEncoderCleanSessions(const std::string &mode) const {
+  boost::optional<const boost::property_tree::ptree &> sessions =
+      storage_.get_child_optional(kEncoderCleanSessions);
+  if (!sessions) {
+    return 0;
+  }
+  return sessions->get(mode, 0);
+}
+
+
 void LocalStorage::SetUserPage(const std::string &user_page) {
   SetValue(kUserPage, user_page);
 }
@@ -120,6 +140,28 @@ void LocalStorage::SetYouTubePrivacy(const std::string &privacy) {
 }
 
 
+void LocalStorage::SetEncoderPreset(
+    const std::string &mode,
+    const std::string &preset) {
+  boost::property_tree::ptree presets =
+      storage_.get_child(kEncoderPresets, boost::property_tree::ptree{});
+  presets.put(mode, preset);
+
+  SetValue(kEncoderPresets, presets);
+}
+
+
+void LocalStorage::SetEncoderCleanSessions(
+    const std::string &mode,
+    int sessions) {
+  boost::property_tree::ptree clean_sessions = storage_.get_child(
+      kEncoderCleanSessions, boost::property_tree::ptree{});
+  clean_sessions.put(mode, sessions);
+
+  SetValue(kEncoderCleanSessions, clean_sessions);
+}
+
+
 LocalStorage::LocalStorage(const std::wstring &storage_path)
     : storage_path_{storage_path},
       storage_{LoadFromFile(storage_path)} {
@@ -195,6 +237,8 @@ const char *LocalStorage::kWindowPosition{"windowPosition"};
 const char *LocalStorage::kWindowPositionX{"x"};
 const char *LocalStorage::kWindowPositionY{"y"};
 const char *LocalStorage::kYouTubePrivacy{"YouTubePrivacy"};
+const char *LocalStorage::kEncoderPresets{"encoderPresets"};
+const char *LocalStorage::kEncoderCleanSessions{"encoderCleanSessions"};
 
 
 LocalStorage *LocalStorage::static_instance{nullptr};
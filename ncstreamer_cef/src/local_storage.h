@@ -30,6 +30,8 @@ class LocalStorage {
   bool GetWebcamUse() const;
   boost::optional<Position<int>> GetWindowPosition() const;
   std::string GetYouTubePrivacy() const;
+  std::string GetEncoderPreset(const std::string &mode) const;
+  int GetEncoderCleanSessions(const std::string &mode) const;
 
   void SetUserPage(const std::string &user_page);
   void SetPrivacy(const std::string &privacy);
@@ -39,6 +41,8 @@ class LocalStorage {
   void SetWebcamUse(const bool &use);
   void SetWindowPosition(const Position<int> &window_position);
   void SetYouTubePrivacy(const std::string &privacy);
+  void SetEncoderPreset(const std::string &mode, const std::string &preset);
+  void SetEncoderCleanSessions(const std::string &mode, int sessions);
 
  private:
   explicit LocalStorage(const std::wstring &storage_path);
@@ -68,6 +72,8 @@ class LocalStorage {
   static const char *kWindowPositionX;
   static const char *kWindowPositionY;
   static const char *kYouTubePrivacy;
+  static const char *kEncoderPresets;
+  static const char *kEncoderCleanSessions;
 
   static LocalStorage *static_instance;
 
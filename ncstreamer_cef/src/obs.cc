@@ -5,13 +5,15 @@
 
 #include "ncstreamer_cef/src/obs.h"
 
+#include <algorithm>
 #include <cassert>
-#include <codecvt>
+#include <chrono>  // NOLINT
+#include <unordered_set>
+#include <utility>
 
 #include "windows.h"  //NOLINT
 
 #include "obs-studio/libobs/graphics/vec2.h"
-#include "obs-studio/plugins/win-capture/graphics-hook-info.h"
 
 #include "ncstreamer_cef/src/local_storage.h"
 #include "ncstreamer_cef/src/obs/obs_source_info.h"
@@ -19,9 +21,9 @@
 
 
 namespace ncstreamer {
-void Obs::SetUp() {
+void Obs::SetUp(std::unique_ptr<ObsBackend> backend) {
   assert(!static_instance);
-  static_instance = new Obs{};
+  static_instance = new Obs{std::move(backend)};
 }
 
 
@@ -38,49 +40,20 @@ Obs *Obs::Get() {
 }
 
 
-std::vector<std::string> Obs::FindAllWindowsOnDesktop() {
-  std::vector<std::string> titles;
-
-  obs_source_t *source =
-      obs_source_create("game_capture", "Game Capture", nullptr, nullptr);
-  obs_properties_t *props = obs_source_properties(source);
-  obs_property_t *prop = obs_properties_get(props, "window");
+ObsWindowIndex::Snapshot Obs::FindAllWindowsOnDesktop() {
+  return window_index_.GetSnapshot();
+}
 
-  int count = obs_property_list_item_count(prop);
-  for (int i = 0; i < count; i++) {
-    const char *val = obs_property_list_item_string(prop, i);
-    if (strlen(val) != 0) {
-      const std::string &decoded = DecodeObsString(val);
-      titles.emplace_back(decoded);
-    }
-  }
 
-  obs_properties_destroy(props);
-  obs_source_release(source);
-  return titles;
+uint64_t Obs::GetWindowsGeneration() const {
+  return window_index_.generation();
 }
 
 
 std::vector<std::string> Obs::FindAllWebcamDevices() {
-  std::vector<std::string> titles;
-
-  obs_source_t *source = obs_source_create(
-      "dshow_input", "VideoCaptureDevice", nullptr, nullptr);
-  obs_properties_t *props = obs_source_properties(source);
-  obs_property_t *prop = obs_properties_get(props, "video_device_id");
-
-  int count = obs_property_list_item_count(prop);
-  for (int i = 0; i < count; i++) {
-    const char *val = obs_property_list_item_string(prop, i);
-    if (strlen(val) != 0) {
-      const std::string &decoded = DecodeObsString(val);
-      titles.emplace_back(decoded);
-    }
-  }
+  WaitForStartUp();
 
-  obs_properties_destroy(props);
-  obs_source_release(source);
-  return titles;
+  return device_catalog_->GetWebcams();
 }
 
 
@@ -88,61 +61,268 @@ bool Obs::StartStreaming(
     const std::string &source_info,
     const std::string &service_provider,
     const std::string &stream_server,
+    const std::vector<std::string> &fallback_servers,
     const std::string &stream_key,
     const ObsOutput::OnStarted &on_streaming_started,
-    const ObsOutput::OnStopped &on_streaming_timeout) {
+    const ObsOutput::OnStopped &on_streaming_stopped,
+    const ObsOutput::OnReconnecting &on_streaming_reconnecting,
+    const ObsOutput::OnRecovered &on_streaming_recovered,
+    const OnStartStage &on_start_stage) {
+  WaitForStartUp();
+  // the UI thread must not wait out the drain of the previous stream.
+  if (stream_output_->IsStopping() == true) {
+    return false;
+  }
+  // logged at start up.
+  if (!audio_encoder_ || !video_encoder_) {
+    return false;
+  }
+
   UpdateVideoSource(source_info);
+  on_start_stage(StartLatencyRecorder::Stage::kSourceUpdated);
   UpdateBaseResolution(source_info);
+  on_start_stage(StartLatencyRecorder::Stage::kBaseResolutionUpdated);
+  scene_switcher_->SwitchTo(kGameplayScene, "", 0);
 
   ResetVideo();
   obs_encoder_set_audio(audio_encoder_, obs_get_audio());
   obs_encoder_set_video(video_encoder_, obs_get_video());
-
-  UpdateCurrentService(service_provider, stream_server, stream_key);
-  UpdateCurrentServiceEncoders(audio_bitrate_, video_bitrate_);
-
-  return stream_output_->Start(
+  on_start_stage(StartLatencyRecorder::Stage::kVideoReset);
+
+  stream_output_->UpdateService(
+      service_provider, stream_server, stream_key, fallback_servers);
+  stream_output_->SetReconnectHandlers(
+      [this, on_streaming_reconnecting](int attempt,
+                                        const std::chrono::milliseconds &delay,
+                                        const std::string &server) {
+    session_journal_.WriteReconnect(attempt, server);
+    on_streaming_reconnecting(attempt, delay, server);
+  }, [this, on_streaming_recovered](int attempts, const std::string &server) {
+    session_journal_.WriteRecovered(attempts, server);
+    on_streaming_recovered(attempts, server);
+  });
+  const int audio_bitrate = audio_bitrate_;
+  const int video_bitrate = video_bitrate_;
+  stream_output_->SetDelay(CapStreamDelay(stream_delay_sec_));
+  UpdateCurrentServiceEncoders(audio_bitrate, video_bitrate);
+  on_start_stage(StartLatencyRecorder::Stage::kServiceUpdated);
+
+  // opened first, so a stop signal racing the start closes this session.
+  boost::property_tree::ptree session;
+  session.put("serviceProvider", service_provider);
+  session.put("streamServer", stream_server);
+  session.put("outputWidth", output_size_.width());
+  session.put("outputHeight", output_size_.height());
+  session.put("fps", fps_);
+  session.put("videoBitrate", video_bitrate);
+  session.put("audioBitrate", audio_bitrate);
+  session.put("videoEncoder", encoder_registry_->video_encoder_id());
+  session_journal_.Open(session);
+
+  // an unexpected stop never goes through StopStreaming.
+  bool started = stream_output_->Start(
       audio_encoder_,
       video_encoder_,
-      current_service_,
       on_streaming_started,
-      on_streaming_timeout);
+      [this, on_streaming_stopped](ObsOutput::StopReason reason) {
+    stats_sampler_.Stop();
+    bitrate_controller_.Stop();
+    session_journal_.Close(reason);
+    on_streaming_stopped(reason);
+  });
+  on_start_stage(StartLatencyRecorder::Stage::kOutputStarting);
+  if (started == false) {
+    session_journal_.Abort();
+    return false;
+  }
+
+  bitrate_controller_.Start(stream_output_.get(), video_bitrate,
+      [this](uint32_t bitrate) {
+    UpdateVideoEncoderBitrate(bitrate);
+  });
+  stats_sampler_.Start(stream_output_.get(),
+      [this](const ObsStatsSampler::Sample &sample) {
+    session_journal_.WriteSample(sample);
+  });
+  return true;
 }
 
 
 void Obs::StopStreaming(
     const ObsOutput::OnStopped &on_streaming_stopped) {
-  ClearSceneItems();
-  stream_output_->Stop(on_streaming_stopped);
+  WaitForStartUp();
+
+  stats_sampler_.Stop();
+  bitrate_controller_.Stop();
+  if (video_preset_.empty() == false) {
+    video_t *video = obs_get_video();
+    encoder_registry_->RecordSession(
+        output_size_,
+        fps_,
+        video_preset_,
+        video_output_get_skipped_frames(video),
+        video_output_get_total_frames(video));
+    video_preset_.clear();
+  }
+
+  static const std::chrono::seconds kDrainTimeout{10};
+
+  {
+    std::lock_guard<std::mutex> lock{simulcast_mutex_};
+    for (auto &output : simulcast_outputs_) {
+      if (output.second->IsActive() == true) {
+        output.second->Stop(simulcast_on_stopped_[output.first],
+                            kDrainTimeout);
+      }
+    }
+  }
+
+  record_output_.Stop();
+  resolution_watcher_.Unwatch();
+
+  // frames rendered after the stop are never sent, so the scene is torn
+  // down here on the caller's thread rather than in the stop callback.
+  scene_cache_->Deactivate();
+  TurnOffWebcam();
+
+  // a delayed stream still has to send everything it has buffered.
+  const std::chrono::seconds drain_timeout =
+      kDrainTimeout + std::chrono::seconds{stream_output_->GetActiveDelay()};
+  stream_output_->Stop([this, on_streaming_stopped](
+      ObsOutput::StopReason reason) {
+    session_journal_.Close(reason);
+    on_streaming_stopped(reason);
+  }, drain_timeout);
 }
 
 
-std::unordered_map<std::string, std::string> Obs::SearchMicDevices() {
-  obs_properties_t *input_props = obs_get_source_properties(
-      "wasapi_input_capture");
-  obs_property_t *prop = obs_properties_get(
-      input_props, "device_id");
-  size_t count = obs_property_list_item_count(prop);
-  std::unordered_map<std::string, std::string> mic_map;
-  for (size_t i = 0; i < count; i++) {
-    const char *val = obs_property_list_item_string(prop, i);
-    const char *name = obs_property_list_item_name(prop, i);
-    mic_map.emplace(val, name);
+std::vector<ObsStatsSampler::Sample> Obs::GetStreamingStats(
+    std::size_t count) const {
+  return stats_sampler_.GetLatest(count);
+}
+
+
+bool Obs::AddSimulcastOutput(
+    const std::string &output_id,
+    const std::string &service_provider,
+    const std::string &stream_server,
+    const std::string &stream_key,
+    const ObsOutput::OnStarted &on_output_started,
+    const ObsOutput::OnStopped &on_output_stopped) {
+  WaitForStartUp();
+
+  if (stream_output_->IsActive() == false) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock{simulcast_mutex_};
+  auto i = simulcast_outputs_.find(output_id);
+  if (i == simulcast_outputs_.end()) {
+    std::unique_ptr<ObsOutput> output{
+        new ObsOutput{"simulcast_stream_" + output_id}};
+    i = simulcast_outputs_.emplace(output_id, std::move(output)).first;
+  } else if (i->second->IsActive() == true) {
+    return false;
+  }
+
+  ObsOutput *output = i->second.get();
+  output->UpdateService(service_provider, stream_server, stream_key, {});
+  simulcast_on_stopped_[output_id] = on_output_stopped;
+  return output->Start(
+      audio_encoder_,
+      video_encoder_,
+      on_output_started,
+      on_output_stopped);
+}
+
+
+bool Obs::RemoveSimulcastOutput(const std::string &output_id) {
+  WaitForStartUp();
+
+  std::lock_guard<std::mutex> lock{simulcast_mutex_};
+  auto i = simulcast_outputs_.find(output_id);
+  if (i == simulcast_outputs_.end() ||
+      i->second->IsActive() == false) {
+    return false;
+  }
+
+  static const std::chrono::seconds kDrainTimeout{10};
+
+  // the output is kept for reuse; its stop signal still needs it alive.
+  i->second->Stop(simulcast_on_stopped_[output_id], kDrainTimeout);
+  return true;
+}
+
+
+bool Obs::StartRecording(
+    const std::string &directory,
+    const std::string &format,
+    uint32_t max_size_mb,
+    uint32_t max_time_sec) {
+  WaitForStartUp();
+
+  if (stream_output_->IsActive() == false) {
+    return false;
   }
-  obs_properties_destroy(input_props);
-  return mic_map;
+  return record_output_.StartRecording(
+      audio_encoder_,
+      video_encoder_,
+      directory,
+      format,
+      max_size_mb,
+      max_time_sec);
+}
+
+
+bool Obs::StartReplayBuffer(
+    const std::string &directory,
+    const std::string &format,
+    uint32_t max_size_mb,
+    uint32_t max_time_sec) {
+  WaitForStartUp();
+
+  if (stream_output_->IsActive() == false) {
+    return false;
+  }
+  return record_output_.StartReplayBuffer(
+      audio_encoder_,
+      video_encoder_,
+      directory,
+      format,
+      max_size_mb,
+      max_time_sec);
+}
+
+
+bool Obs::SaveReplayBuffer() {
+  WaitForStartUp();
+
+  return record_output_.SaveReplayBuffer();
+}
+
+
+void Obs::StopRecording() {
+  WaitForStartUp();
+
+  record_output_.Stop();
+}
+
+
+std::unordered_map<std::string, std::string> Obs::SearchMicDevices() {
+  WaitForStartUp();
+
+  return device_catalog_->GetMics();
 }
 
 
 bool Obs::TurnOnMic(const std::string &device_id, std::string *const error) {
-  obs_sceneitem_t *item = obs_scene_find_source(scene_, "Game Capture");
-  if (item == nullptr) {
+  WaitForStartUp();
+
+  if (scene_cache_->active_item() == nullptr) {
     return false;
   }
 
-  std::unordered_map<std::string, std::string> mic_devices = SearchMicDevices();
-  const auto &iterator = mic_devices.find(device_id);
-  if (iterator == mic_devices.end()) {
+  if (device_catalog_->HasMic(device_id) == false) {
     *error = "no device ID";
     return false;
   }
@@ -152,9 +332,10 @@ bool Obs::TurnOnMic(const std::string &device_id, std::string *const error) {
     obs_data_t *settings = obs_data_create();
     obs_data_set_string(settings, "device_id", device_id.c_str());
     source = obs_source_create(
-        "wasapi_input_capture", "Mic/Aux", settings, nullptr);
+        backend_->mic_source_id(), "Mic/Aux", settings, nullptr);
     obs_data_release(settings);
     obs_set_output_source(3, source);
+    UpdateMicFilters(source);
   } else {
     obs_data_t *settings = obs_source_get_settings(source);
     obs_data_set_string(settings, "device_id", device_id.c_str());
@@ -167,51 +348,171 @@ bool Obs::TurnOnMic(const std::string &device_id, std::string *const error) {
 
 
 bool Obs::TurnOffMic() {
+  WaitForStartUp();
+
+  update_queue_->Discard(ObsUpdateQueue::Key::kMicVolume);
+  source_registry_.RemoveFilter(
+      ObsSourceRegistry::FilterSlot::kMicNoiseSuppression);
+  source_registry_.RemoveFilter(ObsSourceRegistry::FilterSlot::kMicNoiseGate);
   obs_set_output_source(3, nullptr);
   return true;
 }
 
 
 bool Obs::UpdateMicVolume(const float &volume) {
+  WaitForStartUp();
+
   obs_source_t *source = obs_get_output_source(3);
   if (!source) {
     return false;
   }
-  obs_source_set_volume(source, volume);
+
+  std::shared_ptr<obs_source_t> mic{source, obs_source_release};
+  update_queue_->Post(ObsUpdateQueue::Key::kMicVolume, [mic, volume]() {
+    obs_source_set_volume(mic.get(), volume);
+  });
+  return true;
+}
+
+
+bool Obs::UpdateDesktopVolume(const float &volume) {
+  WaitForStartUp();
+
+  obs_source_t *source = obs_get_output_source(1);
+  if (!source) {
+    return false;
+  }
+
+  std::shared_ptr<obs_source_t> desktop{source, obs_source_release};
+  update_queue_->Post(ObsUpdateQueue::Key::kDesktopVolume,
+      [desktop, volume]() {
+    obs_source_set_volume(desktop.get(), volume);
+  });
+  return true;
+}
+
+
+bool Obs::UpdateMicNoiseFilters(bool noise_gate, bool noise_suppression) {
+  WaitForStartUp();
+
+  mic_noise_gate_ = noise_gate;
+  mic_noise_suppression_ = noise_suppression;
+
+  obs_source_t *source = obs_get_output_source(3);
+  if (!source) {
+    return true;
+  }
+  UpdateMicFilters(source);
   obs_source_release(source);
   return true;
 }
 
 
+bool Obs::UpdateAudioFormat(uint32_t sample_rate, speaker_layout speakers) {
+  WaitForStartUp();
+
+  if (sample_rate != 44100 && sample_rate != 48000) {
+    return false;
+  }
+  if (stream_output_->IsActive() == true) {
+    return false;
+  }
+
+  // libobs cannot change the format under live audio sources, so they are
+  // released before the reset and created again after it.
+  float desktop_volume{1.0f};
+  obs_source_t *desktop = obs_get_output_source(1);
+  if (desktop) {
+    desktop_volume = obs_source_get_volume(desktop);
+    obs_source_release(desktop);
+  }
+  std::string mic_device_id{};
+  float mic_volume{1.0f};
+  obs_source_t *mic = obs_get_output_source(3);
+  if (mic) {
+    obs_data_t *settings = obs_source_get_settings(mic);
+    mic_device_id = obs_data_get_string(settings, "device_id");
+    obs_data_release(settings);
+    mic_volume = obs_source_get_volume(mic);
+    obs_source_release(mic);
+  }
+
+  update_queue_->Discard(ObsUpdateQueue::Key::kDesktopVolume);
+  TurnOffMic();
+  obs_set_output_source(1, nullptr);
+
+  audio_sample_rate_ = sample_rate;
+  audio_speakers_ = speakers;
+  const bool reset = ResetAudio();
+
+  AddAudioSource();
+  UpdateDesktopVolume(desktop_volume);
+  if (mic_device_id.empty() == false) {
+    std::string error{};
+    if (TurnOnMic(mic_device_id, &error) == true) {
+      UpdateMicVolume(mic_volume);
+    }
+  }
+  return reset;
+}
+
+
+bool Obs::UpdateAudioQuality(uint32_t bitrate) {
+  static const std::vector<uint32_t> kAacBitrates{
+      64, 96, 128, 160, 192, 256, 320};
+  if (std::find(kAacBitrates.begin(), kAacBitrates.end(), bitrate) ==
+      kAacBitrates.end()) {
+    return false;
+  }
+
+  // the AAC encoders take a new bitrate only when they start.
+  audio_bitrate_ = bitrate;
+  return true;
+}
+
+
 bool Obs::TurnOnWebcam(
     const std::string &device_id, std::string *const error) {
-  obs_sceneitem_t *game_item = obs_scene_find_source(scene_, "Game Capture");
-  if (game_item == nullptr) {
+  WaitForStartUp();
+
+  if (scene_cache_->active_item() == nullptr) {
     return false;
   }
 
-  if (CheckDeviceId(device_id) == false) {
+  if (device_catalog_->HasWebcam(device_id) == false) {
     *error = "no device ID";
     return false;
   }
 
-  obs_sceneitem_t *item = obs_scene_find_source(scene_, "Video Capture Device");
-  if (item == nullptr) {
+  std::shared_ptr<obs_source_t> webcam =
+      source_registry_.item_source(ObsSourceRegistry::ItemSlot::kWebcam);
+  if (!webcam) {
     obs_data_t *settings = obs_data_create();
     obs_data_set_string(settings, "video_device_id", device_id.c_str());
     obs_data_set_int(settings, "res_type", 0);  // Type: Preferred(0), Custom(1)
     obs_source_t *source = obs_source_create(
-        "dshow_input", "Video Capture Device", settings, nullptr);
+        backend_->webcam_source_id(), "Video Capture Device",
+        settings, nullptr);
     obs_data_release(settings);
-    obs_scene_atomic_update(scene_, Obs::AddSourceToScene, source);
+
+    std::pair<obs_source_t *, obs_sceneitem_t *> param{source, nullptr};
+    obs_scene_atomic_update(scene_, Obs::AddSourceToScene, &param);
+    source_registry_.SetItem(
+        ObsSourceRegistry::ItemSlot::kWebcam, param.second);
+
+    // the webcam scene shares the same source, so it is already warm.
+    obs_scene_t *webcam_scene = scene_switcher_->scene(kWebcamScene);
+    std::pair<obs_source_t *, obs_sceneitem_t *> full{source, nullptr};
+    obs_scene_atomic_update(webcam_scene, Obs::AddSourceToScene, &full);
+    obs_scene_atomic_update(webcam_scene, Obs::FitSourceToScene, full.second);
+    source_registry_.SetItem(
+        ObsSourceRegistry::ItemSlot::kWebcamFull, full.second);
     obs_source_release(source);
   } else {
-    obs_source_t *source = obs_get_source_by_name("Video Capture Device");
-    obs_data_t *settings = obs_source_get_settings(source);
+    obs_data_t *settings = obs_source_get_settings(webcam.get());
     obs_data_set_string(settings, "video_device_id", device_id.c_str());
-    obs_source_update(source, settings);
+    obs_source_update(webcam.get(), settings);
     obs_data_release(settings);
-    obs_source_release(source);
   }
 
   return true;
@@ -219,63 +520,105 @@ bool Obs::TurnOnWebcam(
 
 
 bool Obs::TurnOffWebcam() {
-  obs_sceneitem_t *item = obs_scene_find_source(scene_, "Video Capture Device");
-  if (item == nullptr) {
-    return false;
+  WaitForStartUp();
+
+  {
+    std::lock_guard<std::mutex> lock{webcam_size_mutex_};
+    pending_webcam_.reset();
   }
-  obs_sceneitem_remove(item);
-  return true;
+  update_queue_->Discard(ObsUpdateQueue::Key::kWebcamPosition);
+  update_queue_->Discard(ObsUpdateQueue::Key::kChromaKeyColor);
+  update_queue_->Discard(ObsUpdateQueue::Key::kChromaKeySimilarity);
+  source_registry_.RemoveFilter(ObsSourceRegistry::FilterSlot::kChromaKey);
+  if (scene_switcher_->current() == kWebcamScene) {
+    scene_switcher_->SwitchTo(kGameplayScene, "", 0);
+  }
+  source_registry_.RemoveItem(ObsSourceRegistry::ItemSlot::kWebcamFull);
+  return source_registry_.RemoveItem(ObsSourceRegistry::ItemSlot::kWebcam);
 }
 
 
 bool Obs::UpdateWebcamSize(const float &normal_x, const float &normal_y) {
-  obs_sceneitem_t *item = obs_scene_find_source(scene_, "Video Capture Device");
-  if (item == nullptr) {
-    return false;
-  }
+  WaitForStartUp();
 
-  obs_source_t *source = obs_sceneitem_get_source(item);
-  int width{0};
-  int height{0};
-  for (int i = 0; i < 50; ++i) {  // setting webcam source size timing issue.
-    width = obs_source_get_width(source);
-    height = obs_source_get_height(source);
-    if (width != 0 && height != 0) {
-      break;
-    }
-    Sleep(100);
+  std::shared_ptr<obs_sceneitem_t> webcam =
+      source_registry_.item(ObsSourceRegistry::ItemSlot::kWebcam);
+  if (!webcam) {
+    return false;
   }
 
-  vec2 from_size{static_cast<float>(width), static_cast<float>(height)};
-  vec2 to_size{base_size_.width() * normal_x, base_size_.height() * normal_y};
-  vec2 scale;
-  vec2_div(&scale, &to_size, &from_size);
-  obs_sceneitem_set_scale(item, &scale);
+  // the webcam reports no size until its first frame, so the scale is
+  // applied by OnMainRender once the size is known.
+  std::lock_guard<std::mutex> lock{webcam_size_mutex_};
+  pending_webcam_ = webcam;
+  pending_webcam_size_ = Dimension<float>{
+      base_size_.width() * normal_x, base_size_.height() * normal_y};
   return true;
 }
 
 
 bool Obs::UpdateWebcamPosition(const float &normal_x, const float &normal_y) {
-  obs_sceneitem_t *item = obs_scene_find_source(scene_, "Video Capture Device");
-  if (item == nullptr) {
+  WaitForStartUp();
+
+  std::shared_ptr<obs_sceneitem_t> webcam =
+      source_registry_.item(ObsSourceRegistry::ItemSlot::kWebcam);
+  if (!webcam) {
     return false;
   }
 
   vec2 position{base_size_.width() * normal_x, base_size_.height() * normal_y};
-  obs_sceneitem_set_pos(item, &position);
+  update_queue_->Post(ObsUpdateQueue::Key::kWebcamPosition,
+      [webcam, position]() {
+    obs_sceneitem_set_pos(webcam.get(), &position);
+  });
+  return true;
+}
+
+
+bool Obs::UpdateCrop(
+    const Position<float> &normal_position,
+    const Dimension<float> &normal_size) {
+  WaitForStartUp();
+
+  {
+    std::lock_guard<std::mutex> lock{crop_mutex_};
+    crop_position_ = normal_position;
+    crop_size_ = normal_size;
+  }
+
+  // called on the websocket thread while the UI thread may switch sources.
+  std::shared_ptr<obs_sceneitem_t> game_item = scene_cache_->ShareActiveItem();
+  if (!game_item) {
+    return true;
+  }
+  obs_source_t *source = obs_sceneitem_get_source(game_item.get());
+  const Dimension<uint32_t> source_size{
+      obs_source_get_width(source), obs_source_get_height(source)};
+  if (source_size.empty() == true) {
+    return true;
+  }
+
+  const obs_sceneitem_crop &crop = GetCrop(source_size);
+  update_queue_->Post(ObsUpdateQueue::Key::kCrop, [this, game_item, crop]() {
+    obs_sceneitem_set_crop(game_item.get(), &crop);
+    obs_scene_atomic_update(scene_, Obs::FitSourceToScene, game_item.get());
+  });
   return true;
 }
 
 
 bool Obs::TurnOnChromaKey(const uint32_t &color, const int &similarity) {
-  obs_source_t *source = obs_get_source_by_name("Video Capture Device");
-  if (source == nullptr) {
+  WaitForStartUp();
+
+  std::shared_ptr<obs_source_t> webcam =
+      source_registry_.item_source(ObsSourceRegistry::ItemSlot::kWebcam);
+  if (!webcam) {
     return false;
   }
 
-  obs_source_t *filter =
-      obs_source_get_filter_by_name(source, "ChromaKeyFileter");
-  if (filter == nullptr) {
+  std::shared_ptr<obs_source_t> chroma_key =
+      source_registry_.filter(ObsSourceRegistry::FilterSlot::kChromaKey);
+  if (!chroma_key) {
     obs_data_t *settings = obs_data_create();
     obs_data_set_string(settings, "key_color_type", "custom");
     obs_data_set_int(settings, "key_color", color);
@@ -287,77 +630,115 @@ bool Obs::TurnOnChromaKey(const uint32_t &color, const int &similarity) {
     obs_data_set_double(settings, "brightness", 0.0);
     obs_data_set_double(settings, "gamma", 0.0);
 
-    filter = obs_source_create(
+    obs_source_t *filter = obs_source_create(
         "chroma_key_filter", "ChromaKeyFileter", settings, nullptr);
-    obs_source_filter_add(source, filter);
+    obs_data_release(settings);
+    source_registry_.SetFilter(
+        ObsSourceRegistry::FilterSlot::kChromaKey, webcam.get(), filter);
+    obs_source_release(filter);
   } else {
-    obs_data_t *settings = obs_source_get_settings(filter);
+    obs_data_t *settings = obs_source_get_settings(chroma_key.get());
     obs_data_set_int(settings, "key_color", color);
     obs_data_set_int(settings, "similarity", similarity);
-    obs_source_update(filter, settings);
+    obs_source_update(chroma_key.get(), settings);
     obs_data_release(settings);
-    obs_source_release(filter);
   }
-  obs_source_release(filter);
-  obs_source_release(source);
   return true;
 }
 
 
 bool Obs::TurnOffChromaKey() {
-  obs_source_t *source = obs_get_source_by_name("Video Capture Device");
-  if (source == nullptr) {
-    return false;
-  }
-  obs_source_t *filter =
-      obs_source_get_filter_by_name(source, "ChromaKeyFileter");
-  if (filter == nullptr) {
-    return false;
-  }
-  obs_source_filter_remove(source, filter);
-  obs_source_release(source);
-  return true;
+  WaitForStartUp();
+
+  update_queue_->Discard(ObsUpdateQueue::Key::kChromaKeyColor);
+  update_queue_->Discard(ObsUpdateQueue::Key::kChromaKeySimilarity);
+  return source_registry_.RemoveFilter(
+      ObsSourceRegistry::FilterSlot::kChromaKey);
 }
 
 
 bool Obs::UpdateChromaKeyColor(const uint32_t &color) {
-  obs_source_t *source = obs_get_source_by_name("Video Capture Device");
-  if (source == nullptr) {
-    return false;
-  }
-  obs_source_t *filter =
-      obs_source_get_filter_by_name(source, "ChromaKeyFileter");
-  if (filter == nullptr) {
+  WaitForStartUp();
+
+  std::shared_ptr<obs_source_t> chroma_key =
+      source_registry_.filter(ObsSourceRegistry::FilterSlot::kChromaKey);
+  if (!chroma_key) {
     return false;
   }
-  obs_source_release(source);
 
-  obs_data_t *settings = obs_source_get_settings(filter);
-  obs_data_set_int(settings, "key_color", color);
-  obs_source_update(filter, settings);
-  obs_data_release(settings);
-  obs_source_release(filter);
+  update_queue_->Post(ObsUpdateQueue::Key::kChromaKeyColor,
+      [chroma_key, color]() {
+    obs_data_t *settings = obs_source_get_settings(chroma_key.get());
+    obs_data_set_int(settings, "key_color", color);
+    obs_source_update(chroma_key.get(), settings);
+    obs_data_release(settings);
+  });
   return true;
 }
 
 
 bool Obs::UpdateChromaKeySimilarity(const int &similarity) {
-  obs_source_t *source = obs_get_source_by_name("Video Capture Device");
-  if (source == nullptr) {
+  WaitForStartUp();
+
+  std::shared_ptr<obs_source_t> chroma_key =
+      source_registry_.filter(ObsSourceRegistry::FilterSlot::kChromaKey);
+  if (!chroma_key) {
     return false;
   }
-  obs_source_t *filter =
-      obs_source_get_filter_by_name(source, "ChromaKeyFileter");
-  if (filter == nullptr) {
+
+  update_queue_->Post(ObsUpdateQueue::Key::kChromaKeySimilarity,
+      [chroma_key, similarity]() {
+    obs_data_t *settings = obs_source_get_settings(chroma_key.get());
+    obs_data_set_int(settings, "similarity", similarity);
+    obs_source_update(chroma_key.get(), settings);
+    obs_data_release(settings);
+  });
+  return true;
+}
+
+
+std::vector<std::string> Obs::GetSceneNames() const {
+  WaitForStartUp();
+  return scene_switcher_->GetSceneNames();
+}
+
+
+std::string Obs::GetCurrentScene() const {
+  WaitForStartUp();
+  return scene_switcher_->current();
+}
+
+
+bool Obs::SwitchScene(
+    const std::string &scene_name,
+    const std::string &transition_id,
+    uint32_t duration_ms) {
+  WaitForStartUp();
+  return scene_switcher_->SwitchTo(scene_name, transition_id, duration_ms);
+}
+
+
+bool Obs::UpdateBrbScene(
+    const std::string &image_path, const std::string &text) {
+  WaitForStartUp();
+
+  std::shared_ptr<obs_source_t> image =
+      source_registry_.item_source(ObsSourceRegistry::ItemSlot::kBrbImage);
+  std::shared_ptr<obs_source_t> caption =
+      source_registry_.item_source(ObsSourceRegistry::ItemSlot::kBrbText);
+  if (!image || !caption) {
     return false;
   }
-  obs_source_release(source);
 
-  obs_data_t *settings = obs_source_get_settings(filter);
-  obs_data_set_int(settings, "similarity", similarity);
-  obs_source_update(filter, settings);
-  obs_data_release(settings);
-  obs_source_release(filter);
+  obs_data_t *image_settings = obs_source_get_settings(image.get());
+  obs_data_set_string(image_settings, "file", image_path.c_str());
+  obs_source_update(image.get(), image_settings);
+  obs_data_release(image_settings);
+
+  obs_data_t *text_settings = obs_source_get_settings(caption.get());
+  obs_data_set_string(text_settings, "text", text.c_str());
+  obs_source_update(caption.get(), text_settings);
+  obs_data_release(text_settings);
   return true;
 }
 
@@ -366,25 +747,61 @@ void Obs::UpdateVideoQuality(
     const Dimension<uint32_t> &output_size,
     uint32_t fps,
     uint32_t bitrate) {
+  WaitForStartUp();
+
+  const bool resizes = output_size.width() != output_size_.width() ||
+                       output_size.height() != output_size_.height() ||
+                       fps != fps_;
   output_size_ = output_size;
   fps_ = fps;
   video_bitrate_ = bitrate;
+
+  if (stream_output_->IsActive() == false) {
+    return;
+  }
+
+  bitrate_controller_.UpdateMaxBitrate(bitrate);
+  if (resizes) {
+    blog(LOG_INFO, "video quality %ux%u@%u deferred to the next start",
+         output_size_.width(), output_size_.height(), fps_);
+  }
+}
+
+
+uint32_t Obs::UpdateStreamDelay(uint32_t delay_sec) {
+  static const uint32_t kMaxStreamDelaySec{120};
+
+  // libobs only picks up a new delay when the output starts.
+  stream_delay_sec_ = std::min<uint32_t>(delay_sec, kMaxStreamDelaySec);
+  return CapStreamDelay(stream_delay_sec_);
+}
+
+
+uint64_t Obs::GetStreamDelayBufferSize() const {
+  const uint64_t bytes_per_sec =
+      static_cast<uint64_t>(audio_bitrate_ + video_bitrate_) * 1000 / 8;
+  return bytes_per_sec * CapStreamDelay(stream_delay_sec_);
 }
 
 
 void Obs::UpdateCurrentServiceEncoders(
     uint32_t audio_bitrate,
     uint32_t video_bitrate) {
+  WaitForStartUp();
+
+  video_preset_ = encoder_registry_->SelectPreset(output_size_, fps_);
+
   obs_data_t *video_settings = obs_data_create();
   obs_data_set_string(video_settings, "rate_control", "CBR");
   obs_data_set_int(video_settings, "bitrate", video_bitrate);
+  obs_data_set_string(video_settings, "preset", video_preset_.c_str());
 
   obs_data_t *audio_settings = obs_data_create();
   obs_data_set_string(audio_settings, "rate_control", "CBR");
   obs_data_set_int(audio_settings, "bitrate", audio_bitrate);
 
   obs_service_apply_encoder_settings(
-      current_service_, video_settings, audio_settings);
+      stream_output_->service().get(), video_settings, audio_settings);
 
   video_t *video = obs_get_video();
   enum video_format format = video_output_get_format(video);
@@ -402,53 +819,204 @@ void Obs::UpdateCurrentServiceEncoders(
 
 
 void Obs::AddSourceToScene(void *data, obs_scene_t *scene) {
-  obs_source_t *source = reinterpret_cast<obs_source_t *>(data);
-  obs_sceneitem_t *sceneitem = obs_scene_add(scene, source);
-  obs_sceneitem_set_visible(sceneitem, true);
+  auto param = reinterpret_cast<std::pair<obs_source_t *,
+                                          obs_sceneitem_t *> *>(data);
+  param->second = obs_scene_add(scene, param->first);
+  obs_sceneitem_set_visible(param->second, true);
+}
+
+
+void Obs::OnMainRender(void *data, uint32_t /*cx*/, uint32_t /*cy*/) {
+  Obs *self = reinterpret_cast<Obs *>(data);
+
+  std::lock_guard<std::mutex> lock{self->webcam_size_mutex_};
+  if (!self->pending_webcam_) {
+    return;
+  }
+
+  obs_sceneitem_t *item = self->pending_webcam_.get();
+  obs_source_t *source = obs_sceneitem_get_source(item);
+  const uint32_t width = obs_source_get_width(source);
+  const uint32_t height = obs_source_get_height(source);
+  if (width == 0 || height == 0) {
+    return;
+  }
+
+  vec2 scale{self->pending_webcam_size_.width() / width,
+             self->pending_webcam_size_.height() / height};
+  obs_sceneitem_set_scale(item, &scale);
+  self->pending_webcam_.reset();
 }
 
 
-Obs::Obs()
-    : log_file_{},
+void Obs::FitSourceToScene(void *data, obs_scene_t * /*scene*/) {
+  obs_sceneitem_t *item = reinterpret_cast<obs_sceneitem_t *>(data);
+
+  struct obs_video_info ovi;
+  if (obs_get_video_info(&ovi) == false) {
+    return;
+  }
+
+  vec2 bounds{static_cast<float>(ovi.base_width),
+              static_cast<float>(ovi.base_height)};
+  obs_sceneitem_set_bounds_type(item, OBS_BOUNDS_SCALE_INNER);
+  obs_sceneitem_set_bounds_alignment(item, OBS_ALIGN_CENTER);
+  obs_sceneitem_set_bounds(item, &bounds);
+}
+
+
+Obs::Obs(std::unique_ptr<ObsBackend> backend)
+    : backend_{std::move(backend)},
+      log_file_{},
+      encoder_registry_{},
+      device_catalog_{},
+      window_index_{},
       audio_encoder_{nullptr},
       video_encoder_{nullptr},
       stream_output_{},
+      simulcast_mutex_{},
+      simulcast_outputs_{},
+      simulcast_on_stopped_{},
+      record_output_{},
+      bitrate_controller_{},
+      stats_sampler_{},
       scene_{nullptr},
-      current_service_{nullptr},
+      scene_cache_{},
+      scene_switcher_{},
+      source_registry_{},
+      update_queue_{},
+      webcam_size_mutex_{},
+      pending_webcam_{},
+      pending_webcam_size_{0.0f, 0.0f},
+      resolution_watcher_{},
+      crop_mutex_{},
+      crop_position_{0.0f, 0.0f},
+      crop_size_{1.0f, 1.0f},
+      mic_noise_gate_{true},
+      mic_noise_suppression_{true},
+      audio_sample_rate_{48000},
+      audio_speakers_{SPEAKERS_STEREO},
       audio_bitrate_{160},
       video_bitrate_{2500},
+      stream_delay_sec_{0},
       base_size_{1920, 1080},
       output_size_{1280, 720},
-      fps_{30} {
+      scale_policy_{ObsScalePolicy::kDefaultBudget},
+      session_journal_{GetSessionJournalDirectory()},
+      fps_{30},
+      video_preset_{},
+      start_up_{} {
   SetUpLog();
+  start_up_ = std::async(std::launch::async, &Obs::StartUp, this).share();
+}
+
+
+Obs::~Obs() {
+  start_up_.wait();
+  for (auto &output : simulcast_outputs_) {
+    output.second->WaitForStop();
+  }
+  stream_output_->WaitForStop();
+
+  obs_remove_main_render_callback(Obs::OnMainRender, this);
+  pending_webcam_.reset();
+  update_queue_.reset();
+  stats_sampler_.Stop();
+  bitrate_controller_.Stop();
+  resolution_watcher_.Unwatch();
+  source_registry_.Clear();
+  scene_cache_.reset();
+  ClearSceneItems();
+  ClearSceneData();
+
+  scene_switcher_.reset();
+  obs_scene_release(scene_);
+  device_catalog_.reset();
+  record_output_.Stop();
+  simulcast_outputs_.clear();
+  simulcast_on_stopped_.clear();
+  stream_output_.reset();
+  obs_encoder_release(video_encoder_);
+  obs_encoder_release(audio_encoder_);
+
+  obs_shutdown();
+}
+
+
+bool Obs::IsReady() const {
+  return start_up_.wait_for(std::chrono::seconds{0}) ==
+         std::future_status::ready;
+}
+
+
+void Obs::WaitForStartUp() const {
+  start_up_.wait();
+}
+
+
+void Obs::StartUp() {
   obs_startup("en-US", nullptr, nullptr);
-  obs_load_all_modules();
+  LoadModules();
   obs_log_loaded_modules();
 
+  encoder_registry_.reset(new ObsEncoderRegistry{});
+  device_catalog_.reset(new ObsDeviceCatalog{
+      backend_->device_notification(),
+      backend_->webcam_source_id(),
+      backend_->mic_source_id()});
   audio_encoder_ = CreateAudioEncoder();
   video_encoder_ = CreateVideoEncoder();
 
-  stream_output_.reset(new ObsOutput{});
+  stream_output_.reset(new ObsOutput{"simple_stream"});
 
-  scene_ = obs_scene_create("Scene");
+  scene_ = obs_scene_create(kGameplayScene);
+  scene_cache_.reset(new ObsSceneCache{scene_, backend_->game_source_id()});
+  scene_switcher_.reset(new ObsSceneSwitcher{kGameplayScene, scene_});
+  scene_switcher_->AddScene(kBrbScene);
+  scene_switcher_->AddScene(kWebcamScene);
+  update_queue_.reset(new ObsUpdateQueue{});
 
   AddAudioSource();
   ResetAudio();
   ResetVideo();
+  SetUpBrbScene();
+
+  obs_add_main_render_callback(Obs::OnMainRender, this);
 }
 
 
-Obs::~Obs() {
-  ReleaseCurrentService();
-  ClearSceneItems();
-  ClearSceneData();
+void Obs::LoadModules() {
+  // only the modules the backend lists as providing the source, encoder,
+  // output, service and filter types this app creates.
+  obs_find_modules([](void *param, const struct obs_module_info *info) {
+    const auto &modules =
+        *reinterpret_cast<const std::unordered_set<std::string> *>(param);
+    const std::string &bin_path{info->bin_path};
+    const std::size_t name_begin = bin_path.find_last_of("/\\") + 1;
+    const std::size_t name_end = bin_path.rfind('.');
+    const std::string &name =
+        bin_path.substr(name_begin, name_end - name_begin);
+    if (modules.find(name) == modules.end()) {
+      return;
+    }
 
-  obs_scene_release(scene_);
-  stream_output_.reset();
-  obs_encoder_release(video_encoder_);
-  obs_encoder_release(audio_encoder_);
+    obs_module_t *module{nullptr};
+    int code = obs_open_module(&module, info->bin_path, info->data_path);
+    if (code != MODULE_SUCCESS) {
+      blog(LOG_WARNING, "failed to open module: %s(%d)", name.c_str(), code);
+      return;
+    }
+    obs_init_module(module);
+  }, const_cast<std::unordered_set<std::string> *>(&backend_->modules()));
+}
 
-  obs_shutdown();
+
+std::string Obs::GetSessionJournalDirectory() {
+  char path[512];
+  if (obs_app::GetConfigPath(path, sizeof(path), "obs-studio/sessions") <= 0) {
+    return "";
+  }
+  return path;
 }
 
 
@@ -463,44 +1031,161 @@ bool Obs::SetUpLog() {
 }
 
 
-void Obs::ResetAudio() {
+bool Obs::ResetAudio() {
   struct obs_audio_info ai;
-  ai.samples_per_sec = 44100;
-  ai.speakers = SPEAKERS_STEREO;
+  ai.samples_per_sec = audio_sample_rate_;
+  ai.speakers = audio_speakers_;
 
-  obs_reset_audio(&ai);
+  return obs_reset_audio(&ai);
+}
+
+
+void Obs::UpdateMicFilters(obs_source_t *mic) {
+  using FilterSlot = ObsSourceRegistry::FilterSlot;
+  static const std::vector<std::tuple<FilterSlot, const char *, const char *>>
+      kFilters{
+          std::make_tuple(FilterSlot::kMicNoiseSuppression,
+                          "noise_suppress_filter", "Mic Noise Suppression"),
+          std::make_tuple(FilterSlot::kMicNoiseGate,
+                          "noise_gate_filter", "Mic Noise Gate")};
+
+  const bool enables[] = {mic_noise_suppression_, mic_noise_gate_};
+  for (std::size_t i = 0; i < kFilters.size(); ++i) {
+    const FilterSlot slot = std::get<0>(kFilters[i]);
+    if (enables[i] == false) {
+      source_registry_.RemoveFilter(slot);
+      continue;
+    }
+    if (source_registry_.filter(slot)) {
+      continue;
+    }
+
+    obs_source_t *filter = obs_source_create(
+        std::get<1>(kFilters[i]), std::get<2>(kFilters[i]), nullptr, nullptr);
+    source_registry_.SetFilter(slot, mic, filter);
+    obs_source_release(filter);
+  }
 }
 
 
 void Obs::ResetVideo() {
+  const ObsScalePolicy::Choice &scale =
+      scale_policy_.Choose(base_size_, output_size_, fps_);
+  blog(LOG_INFO, "scale: %s, colorspace: %s",
+       ObsScalePolicy::ToString(scale.scale_type),
+       ObsScalePolicy::ToString(scale.colorspace));
+
   struct obs_video_info ovi;
   ovi.fps_num = fps_;
   ovi.fps_den = 1;
-  ovi.graphics_module = "libobs-d3d11.dll";
+  ovi.graphics_module = backend_->graphics_module();
   ovi.base_width = base_size_.width();
   ovi.base_height = base_size_.height();
   ovi.output_width = output_size_.width();
   ovi.output_height = output_size_.height();
   ovi.output_format = VIDEO_FORMAT_NV12;
-  ovi.colorspace = VIDEO_CS_601;
+  ovi.colorspace = scale.colorspace;
   ovi.range = VIDEO_RANGE_PARTIAL;
   ovi.adapter = 0;
   ovi.gpu_conversion = true;
-  ovi.scale_type = OBS_SCALE_BICUBIC;
+  ovi.scale_type = scale.scale_type;
 
   obs_reset_video(&ovi);
 }
 
 
+void Obs::SetUpBrbScene() {
+  static const char *kDefaultText{"Be right back"};
+  static const int kFontSize{72};
+
+  obs_scene_t *brb_scene = scene_switcher_->scene(kBrbScene);
+
+  // the image is filled in by UpdateBrbScene; until then it draws nothing.
+  obs_source_t *image = obs_source_create(
+      backend_->image_source_id(), "BRB Image", nullptr, nullptr);
+  std::pair<obs_source_t *, obs_sceneitem_t *> image_param{image, nullptr};
+  obs_scene_atomic_update(brb_scene, Obs::AddSourceToScene, &image_param);
+  obs_scene_atomic_update(
+      brb_scene, Obs::FitSourceToScene, image_param.second);
+  source_registry_.SetItem(
+      ObsSourceRegistry::ItemSlot::kBrbImage, image_param.second);
+  obs_source_release(image);
+
+  obs_data_t *font = obs_data_create();
+  obs_data_set_int(font, "size", kFontSize);
+  obs_data_t *settings = obs_data_create();
+  obs_data_set_string(settings, "text", kDefaultText);
+  obs_data_set_obj(settings, "font", font);
+  obs_source_t *caption = obs_source_create(
+      backend_->text_source_id(), "BRB Text", settings, nullptr);
+  obs_data_release(settings);
+  obs_data_release(font);
+
+  // added last, so the text is drawn over the image.
+  std::pair<obs_source_t *, obs_sceneitem_t *> text_param{caption, nullptr};
+  obs_scene_atomic_update(brb_scene, Obs::AddSourceToScene, &text_param);
+  struct obs_video_info ovi;
+  if (obs_get_video_info(&ovi) == true) {
+    vec2 center{static_cast<float>(ovi.base_width) / 2,
+                static_cast<float>(ovi.base_height) / 2};
+    obs_sceneitem_set_alignment(text_param.second, OBS_ALIGN_CENTER);
+    obs_sceneitem_set_pos(text_param.second, &center);
+  }
+  source_registry_.SetItem(
+      ObsSourceRegistry::ItemSlot::kBrbText, text_param.second);
+  obs_source_release(caption);
+}
+
+
 obs_encoder_t *Obs::CreateAudioEncoder() {
+    const std::string &id = encoder_registry_->audio_encoder_id();
+    if (id.empty() == true) {
+      blog(LOG_ERROR, "no audio encoder is available");
+      return nullptr;
+    }
     return obs_audio_encoder_create(
-        "ffmpeg_aac", "simple_aac", nullptr, 0, nullptr);
+        id.c_str(), "simple_aac", nullptr, 0, nullptr);
 }
 
 
 obs_encoder_t *Obs::CreateVideoEncoder() {
+    const std::string &id = encoder_registry_->video_encoder_id();
+    if (id.empty() == true) {
+      blog(LOG_ERROR, "no video encoder is available");
+      return nullptr;
+    }
     return obs_video_encoder_create(
-        "obs_x264", "simple_h264_stream", nullptr, nullptr);
+        id.c_str(), "simple_h264_stream", nullptr, nullptr);
+}
+
+
+void Obs::UpdateVideoEncoderBitrate(uint32_t video_bitrate) {
+  obs_data_t *video_settings = obs_data_create();
+  obs_data_set_string(video_settings, "rate_control", "CBR");
+  obs_data_set_int(video_settings, "bitrate", video_bitrate);
+
+  const std::shared_ptr<obs_service_t> &service = stream_output_->service();
+  if (service) {
+    obs_service_apply_encoder_settings(service.get(), video_settings, nullptr);
+  }
+
+  obs_encoder_update(video_encoder_, video_settings);
+  obs_data_release(video_settings);
+}
+
+
+uint32_t Obs::CapStreamDelay(uint32_t delay_sec) const {
+  static const uint64_t kMaxBufferSize{64 * 1024 * 1024};
+
+  // the delayed packets are held in memory; a long delay at a high bitrate
+  // is shortened rather than refused.
+  const uint64_t bytes_per_sec =
+      static_cast<uint64_t>(audio_bitrate_ + video_bitrate_) * 1000 / 8;
+  if (bytes_per_sec == 0) {
+    return delay_sec;
+  }
+  return static_cast<uint32_t>(
+      std::min<uint64_t>(delay_sec, kMaxBufferSize / bytes_per_sec));
 }
 
 
@@ -530,16 +1215,7 @@ void Obs::ClearSceneData() {
 
 
 void Obs::UpdateVideoSource(const std::string &source_info) {
-  obs_data_t *settings = obs_data_create();
-  obs_data_set_string(settings, "window", source_info.c_str());
-  obs_data_set_string(settings, "capture_mode", "window");
-  obs_source_t *source = obs_source_create(
-      "game_capture", "Game Capture", settings, nullptr);
-  obs_data_release(settings);
-  obs_scene_atomic_update(scene_, Obs::AddSourceToScene, source);
-  obs_source_release(source);
-
-  obs_set_output_source(0, obs_get_source_by_name("Scene"));
+  scene_cache_->Activate(source_info);
 }
 
 
@@ -554,7 +1230,8 @@ void Obs::AddAudioSource() {
   obs_data_set_string(settings, "device_id", "default");
 
   source = obs_source_create(
-      "wasapi_output_capture", "Desktop Audio", settings, nullptr);
+      backend_->desktop_audio_source_id(), "Desktop Audio",
+      settings, nullptr);
   obs_data_release(settings);
 
   obs_set_output_source(1, source);
@@ -562,93 +1239,77 @@ void Obs::AddAudioSource() {
 }
 
 
-void Obs::UpdateCurrentService(
-    const std::string &service_provider,
-    const std::string &stream_server,
-    const std::string &stream_key) {
-  ReleaseCurrentService();
-
-  obs_data_t *settings = obs_data_create();
-  obs_data_set_string(settings, "service", service_provider.c_str());
-  obs_data_set_string(settings, "server", stream_server.c_str());
-  obs_data_set_string(settings, "key", stream_key.c_str());
-  obs_data_set_bool(settings, "show_all", false);
-
-  current_service_ = obs_service_create(
-      "rtmp_common", "default_service", settings, nullptr);
-  obs_data_release(settings);
-}
-
+void Obs::UpdateBaseResolution(const std::string &source_info) {
+  obs_sceneitem_t *item = scene_cache_->active_item();
+  const Dimension<uint32_t> &window_size = backend_->GetSourceSize(
+      source_info, item ? obs_sceneitem_get_source(item) : nullptr);
+  if (window_size.width() != 0 && window_size.height() != 0) {
+    // only the cropped region is rendered and scaled.
+    base_size_ = GetCroppedSize(window_size);
+  }
 
-void Obs::ReleaseCurrentService() {
-  if (!current_service_) {
+  if (item == nullptr) {
     return;
   }
-  obs_service_release(current_service_);
-  current_service_ = nullptr;
+  if (window_size.empty() == false) {
+    const obs_sceneitem_crop &crop = GetCrop(window_size);
+    obs_sceneitem_set_crop(item, &crop);
+  }
+  obs_sceneitem_addref(item);
+  std::shared_ptr<obs_sceneitem_t> game_item{item, obs_sceneitem_release};
+
+  resolution_watcher_.Watch(source_info,
+      [this, game_item](const Dimension<uint32_t> &hooked_size) {
+    OnHookResolutionChanged(game_item.get(), hooked_size);
+  });
 }
 
 
-void Obs::UpdateBaseResolution(const std::string &source_info) {
-  ObsSourceInfo source{source_info};
-  const std::string &clazz = source.clazz();
-  const std::string &title = source.title();
-
-  std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
-  const std::wstring &w_class = converter.from_bytes(clazz);
-  const std::wstring &w_title = converter.from_bytes(title);
-
-  HWND handle = ::FindWindowExW(
-      nullptr, nullptr, w_class.c_str(), w_title.c_str());
-  DWORD process_id;
-  GetWindowThreadProcessId(handle, &process_id);
-  std::wstring map_name = L"CaptureHook_HookInfo" + std::to_wstring(process_id);
-  for (int i = 0; i < 200; ++i) {
-    HANDLE hook_info_map = OpenFileMapping(
-        FILE_MAP_READ, false, map_name.c_str());
-    if (hook_info_map) {
-      struct hook_info *info = reinterpret_cast<struct hook_info *>(
-          MapViewOfFile(hook_info_map, FILE_MAP_READ, 0, 0, sizeof(info)));
-      if (info && info->cx != 0 && info->cy != 0) {
-        base_size_ = {info->cx, info->cy};
-        break;
-      }
-    }
-    Sleep(100);
-  }
+void Obs::OnHookResolutionChanged(
+    obs_sceneitem_t *game_item,
+    const Dimension<uint32_t> &hooked_size) {
+  blog(LOG_INFO, "hooked resolution: %ux%u",
+       hooked_size.width(), hooked_size.height());
+
+  const obs_sceneitem_crop &crop = GetCrop(hooked_size);
+  obs_sceneitem_set_crop(game_item, &crop);
+  obs_scene_atomic_update(scene_, Obs::FitSourceToScene, game_item);
 }
 
 
-const bool Obs::CheckDeviceId(const std::string &device_id) {
-  const std::vector<std::string> &webcams{FindAllWebcamDevices()};
-  for (auto webcam : webcams) {
-    if (webcam == device_id) {
-      return true;
-    }
-  }
-  return false;
+Dimension<uint32_t> Obs::GetCroppedSize(
+    const Dimension<uint32_t> &source_size) const {
+  const obs_sceneitem_crop &crop = GetCrop(source_size);
+  // NV12 needs even dimensions.
+  const uint32_t width = source_size.width() - crop.left - crop.right;
+  const uint32_t height = source_size.height() - crop.top - crop.bottom;
+  return Dimension<uint32_t>{std::max<uint32_t>(width & ~1u, 2),
+                             std::max<uint32_t>(height & ~1u, 2)};
 }
 
 
-const std::string Obs::DecodeObsString(
-    const std::string &encoded_string) {
-  std::string decoded{encoded_string};
-  ReplaceString(&decoded, "#3A", ":");
-  ReplaceString(&decoded, "#22", "#");
-  return decoded;
+obs_sceneitem_crop Obs::GetCrop(
+    const Dimension<uint32_t> &source_size) const {
+  std::lock_guard<std::mutex> lock{crop_mutex_};
+  const float width = static_cast<float>(source_size.width());
+  const float height = static_cast<float>(source_size.height());
+
+  obs_sceneitem_crop crop;
+  crop.left = static_cast<int>(width * crop_position_.x());
+  crop.top = static_cast<int>(height * crop_position_.y());
+  crop.right = static_cast<int>(
+      width * (1.0f - crop_position_.x() - crop_size_.width()));
+  crop.bottom = static_cast<int>(
+      height * (1.0f - crop_position_.y() - crop_size_.height()));
+  crop.right = std::max<int>(crop.right, 0);
+  crop.bottom = std::max<int>(crop.bottom, 0);
+  return crop;
 }
 
 
-void Obs::ReplaceString(
-      std::string *subject,
-      const std::string &search,
-      const std::string &replace) {
-  size_t pos{0};
-  while ((pos = subject->find(search, pos)) != std::string::npos) {
-    subject->replace(pos, search.length(), replace);
-    pos += replace.length();
-  }
-}
+const char *Obs::kGameplayScene{"gameplay"};
+const char *Obs::kBrbScene{"brb"};
+const char *Obs::kWebcamScene{"webcam"};
 
 
 Obs *Obs::static_instance{nullptr};
@@ -7,8 +7,12 @@
 #define NCSTREAMER_CEF_SRC_OBS_H_
 
 
+#include <atomic>
 #include <fstream>
+#include <functional>
+#include <future>  // NOLINT
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -18,33 +22,98 @@
 #include "obs-studio/libobs/obs.h"
 
 #include "ncstreamer_cef/src/lib/dimension.h"
+#include "ncstreamer_cef/src/lib/position.h"
+#include "ncstreamer_cef/src/obs/obs_backend.h"
+#include "ncstreamer_cef/src/obs/obs_bitrate_controller.h"
+#include "ncstreamer_cef/src/obs/obs_device_catalog.h"
+#include "ncstreamer_cef/src/obs/obs_encoder_registry.h"
 #include "ncstreamer_cef/src/obs/obs_output.h"
+#include "ncstreamer_cef/src/obs/obs_record_output.h"
+#include "ncstreamer_cef/src/obs/obs_resolution_watcher.h"
+#include "ncstreamer_cef/src/obs/obs_scale_policy.h"
+#include "ncstreamer_cef/src/obs/obs_scene_cache.h"
+#include "ncstreamer_cef/src/obs/obs_scene_switcher.h"
+#include "ncstreamer_cef/src/obs/obs_session_journal.h"
+#include "ncstreamer_cef/src/obs/obs_source_registry.h"
+#include "ncstreamer_cef/src/obs/obs_stats_sampler.h"
+#include "ncstreamer_cef/src/obs/obs_update_queue.h"
+#include "ncstreamer_cef/src/obs/obs_window_index.h"
+#include "ncstreamer_cef/src/start_latency_recorder.h"
 
 
 namespace ncstreamer {
 class Obs {
  public:
-  static void SetUp();
+  static const char *kGameplayScene;
+  static const char *kBrbScene;
+  static const char *kWebcamScene;
+
+  using OnStartStage =
+      std::function<void(StartLatencyRecorder::Stage stage)>;
+
+  static void SetUp(std::unique_ptr<ObsBackend> backend);
   static void ShutDown();
   static Obs *Get();
 
-  std::vector<std::string> FindAllWindowsOnDesktop();
+  // libobs starts up in the background; the calls below that need it wait.
+  bool IsReady() const;
+
+  ObsWindowIndex::Snapshot FindAllWindowsOnDesktop();
+  uint64_t GetWindowsGeneration() const;
   std::vector<std::string> FindAllWebcamDevices();
 
+  // fails at once while the previous stream is still stopping.
+  // on_start_stage is called on the calling thread as each stage ends.
   bool StartStreaming(
       const std::string &source_info,
       const std::string &service_provider,
       const std::string &stream_server,
+      const std::vector<std::string> &fallback_servers,
       const std::string &stream_key,
       const ObsOutput::OnStarted &on_streaming_started,
-      const ObsOutput::OnStopped &on_streaming_timeout);
+      const ObsOutput::OnStopped &on_streaming_stopped,
+      const ObsOutput::OnReconnecting &on_streaming_reconnecting,
+      const ObsOutput::OnRecovered &on_streaming_recovered,
+      const OnStartStage &on_start_stage);
   void StopStreaming(
       const ObsOutput::OnStopped &on_streaming_stopped);
 
+  std::vector<ObsStatsSampler::Sample> GetStreamingStats(
+      std::size_t count) const;
+
+  // on_output_stopped is called however the output stops, including by
+  // RemoveSimulcastOutput and StopStreaming.
+  bool AddSimulcastOutput(
+      const std::string &output_id,
+      const std::string &service_provider,
+      const std::string &stream_server,
+      const std::string &stream_key,
+      const ObsOutput::OnStarted &on_output_started,
+      const ObsOutput::OnStopped &on_output_stopped);
+  bool RemoveSimulcastOutput(const std::string &output_id);
+
+  bool StartRecording(
+      const std::string &directory,
+      const std::string &format,
+      uint32_t max_size_mb,
+      uint32_t max_time_sec);
+  bool StartReplayBuffer(
+      const std::string &directory,
+      const std::string &format,
+      uint32_t max_size_mb,
+      uint32_t max_time_sec);
+  bool SaveReplayBuffer();
+  void StopRecording();
+
   std::unordered_map<std::string, std::string> SearchMicDevices();
   bool TurnOnMic(const std::string &device_id, std::string *const error);
   bool TurnOffMic();
   bool UpdateMicVolume(const float &volume);
+  bool UpdateDesktopVolume(const float &volume);
+  bool UpdateMicNoiseFilters(bool noise_gate, bool noise_suppression);
+  // not while streaming; the audio sources are created again.
+  bool UpdateAudioFormat(uint32_t sample_rate, speaker_layout speakers);
+  bool UpdateAudioQuality(uint32_t bitrate);
   bool TurnOnWebcam(const std::string &device_id, std::string *const error);
   bool TurnOffWebcam();
   bool UpdateWebcamSize(const float &normal_x, const float &normal_y);
@@ -53,10 +122,26 @@ class Obs {
   bool TurnOffChromaKey();
   bool UpdateChromaKeyColor(const uint32_t &color);
   bool UpdateChromaKeySimilarity(const int &similarity);
+  std::vector<std::string> GetSceneNames() const;
+  std::string GetCurrentScene() const;
+  bool SwitchScene(
+      const std::string &scene_name,
+      const std::string &transition_id,
+      uint32_t duration_ms);
+  // an empty image_path leaves the brb scene with the text only.
+  bool UpdateBrbScene(const std::string &image_path, const std::string &text);
   void UpdateVideoQuality(
       const Dimension<uint32_t> &output_size,
       uint32_t fps,
       uint32_t bitrate);
+  // returns the delay that fits the buffer cap at the current bitrates.
+  uint32_t UpdateStreamDelay(uint32_t delay_sec);
+  // the game capture is cropped at once; the canvas follows the cropped
+  // size from the next start.
+  bool UpdateCrop(
+      const Position<float> &normal_position,
+      const Dimension<float> &normal_size);
+  uint64_t GetStreamDelayBufferSize() const;
 
   void UpdateCurrentServiceEncoders(
       uint32_t audio_bitrate,
@@ -64,49 +149,87 @@ class Obs {
 
  private:
   static void AddSourceToScene(void *data, obs_scene_t *scene);
+  static void FitSourceToScene(void *data, obs_scene_t *scene);
+  static void OnMainRender(void *data, uint32_t cx, uint32_t cy);
+  static std::string GetSessionJournalDirectory();
 
-  Obs();
+  explicit Obs(std::unique_ptr<ObsBackend> backend);
   virtual ~Obs();
 
+  void WaitForStartUp() const;
+  void StartUp();
+  void LoadModules();
   bool SetUpLog();
-  void ResetAudio();
+  bool ResetAudio();
+  void UpdateMicFilters(obs_source_t *mic);
   void ResetVideo();
+  void SetUpBrbScene();
   obs_encoder_t *CreateAudioEncoder();
   obs_encoder_t *CreateVideoEncoder();
+  void UpdateVideoEncoderBitrate(uint32_t video_bitrate);
+  uint32_t CapStreamDelay(uint32_t delay_sec) const;
   void ClearSceneItems();
   void ClearSceneData();
 
   void UpdateVideoSource(const std::string &source_info);
   void AddAudioSource();
 
-  void UpdateCurrentService(
-      const std::string &service_provider,
-      const std::string &stream_server,
-      const std::string &stream_key);
-  void ReleaseCurrentService();
   void UpdateBaseResolution(const std::string &source_info);
-  const bool CheckDeviceId(const std::string &device_id);
-  const std::string DecodeObsString(
-      const std::string &encoded_string);
-  void ReplaceString(
-      std::string *subject,
-      const std::string &search,
-      const std::string &replace);
+  Dimension<uint32_t> GetCroppedSize(
+      const Dimension<uint32_t> &source_size) const;
+  obs_sceneitem_crop GetCrop(const Dimension<uint32_t> &source_size) const;
+  void OnHookResolutionChanged(
+      obs_sceneitem_t *game_item,
+      const Dimension<uint32_t> &hooked_size);
 
   static Obs *static_instance;
 
+  const std::unique_ptr<ObsBackend> backend_;
   std::fstream log_file_;
+  std::unique_ptr<ObsEncoderRegistry> encoder_registry_;
+  std::unique_ptr<ObsDeviceCatalog> device_catalog_;
+  ObsWindowIndex window_index_;
   obs_encoder_t *audio_encoder_;
   obs_encoder_t *video_encoder_;
   std::unique_ptr<ObsOutput> stream_output_;
+  // This mutex is used to synchronize accesses to the simulcast members.
+  std::mutex simulcast_mutex_;
+  std::unordered_map<std::string /*output id*/,
+                     std::unique_ptr<ObsOutput>> simulcast_outputs_;
+  std::unordered_map<std::string /*output id*/,
+                     ObsOutput::OnStopped> simulcast_on_stopped_;
+  ObsRecordOutput record_output_;
+  ObsBitrateController bitrate_controller_;
+  ObsStatsSampler stats_sampler_;
   obs_scene_t *scene_;
-
-  obs_service_t *current_service_;
-  int audio_bitrate_;
-  int video_bitrate_;
+  std::unique_ptr<ObsSceneCache> scene_cache_;
+  std::unique_ptr<ObsSceneSwitcher> scene_switcher_;
+  ObsSourceRegistry source_registry_;
+  std::unique_ptr<ObsUpdateQueue> update_queue_;
+  std::mutex webcam_size_mutex_;
+  std::shared_ptr<obs_sceneitem_t> pending_webcam_;
+  Dimension<float> pending_webcam_size_;
+  ObsResolutionWatcher resolution_watcher_;
+  mutable std::mutex crop_mutex_;
+  Position<float> crop_position_;
+  Dimension<float> crop_size_;
+
+  bool mic_noise_gate_;
+  bool mic_noise_suppression_;
+  uint32_t audio_sample_rate_;
+  speaker_layout audio_speakers_;
+  // set from the websocket thread while a start reads them.
+  std::atomic<int> audio_bitrate_;
+  std::atomic<int> video_bitrate_;
+  std::atomic<uint32_t> stream_delay_sec_;
   Dimension<uint32_t> base_size_;
   Dimension<uint32_t> output_size_;
+  ObsScalePolicy scale_policy_;
+  ObsSessionJournal session_journal_;
   uint32_t fps_;
+  std::string video_preset_;
+
+  std::shared_future<void> start_up_;
 };
 }  // namespace ncstreamer
 
@@ -0,0 +1,23 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/obs/obs_backend.h"
+
+#include "ncstreamer_cef/src/obs/obs_headless_backend.h"
+#include "ncstreamer_cef/src/obs/obs_windows_backend.h"
+
+
+namespace ncstreamer {
+std::unique_ptr<ObsBackend> ObsBackend::Create(const std::wstring &name) {
+  if (name == L"headless") {
+    return std::unique_ptr<ObsBackend>{new ObsHeadlessBackend{}};
+  }
+  return std::unique_ptr<ObsBackend>{new ObsWindowsBackend{}};
+}
+
+
+ObsBackend::~ObsBackend() {
+}
+}  // namespace ncstreamer
@@ -0,0 +1,48 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_OBS_OBS_BACKEND_H_
+#define NCSTREAMER_CEF_SRC_OBS_OBS_BACKEND_H_
+
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+#include "obs-studio/libobs/obs.h"
+
+#include "ncstreamer_cef/src/lib/dimension.h"
+#include "ncstreamer_cef/src/obs/obs_device_catalog.h"
+
+
+namespace ncstreamer {
+// The platform pieces under Obs: the graphics module, the modules to load
+// and the source types for capture.
+class ObsBackend {
+ public:
+  // "headless" selects ObsHeadlessBackend; anything else ObsWindowsBackend.
+  static std::unique_ptr<ObsBackend> Create(const std::wstring &name);
+
+  virtual ~ObsBackend() = 0;
+
+  virtual const char *graphics_module() const = 0;
+  virtual const std::unordered_set<std::string> &modules() const = 0;
+  virtual ObsDeviceCatalog::Notification device_notification() const = 0;
+
+  virtual const char *game_source_id() const = 0;
+  virtual const char *webcam_source_id() const = 0;
+  virtual const char *mic_source_id() const = 0;
+  virtual const char *desktop_audio_source_id() const = 0;
+  virtual const char *image_source_id() const = 0;
+  virtual const char *text_source_id() const = 0;
+
+  // the size the base canvas follows; source is the active game source.
+  virtual Dimension<uint32_t> GetSourceSize(
+      const std::string &source_info, obs_source_t *source) const = 0;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_OBS_OBS_BACKEND_H_
@@ -0,0 +1,61 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/obs/obs_backoff_reconnect_policy.h"
+
+#include <algorithm>
+
+
+namespace ncstreamer {
+ObsBackoffReconnectPolicy::ObsBackoffReconnectPolicy(
+    const std::chrono::milliseconds &initial_delay,
+    const std::chrono::milliseconds &max_delay,
+    const std::chrono::milliseconds &max_elapsed,
+    int attempts_per_server)
+    : initial_delay_{initial_delay},
+      max_delay_{max_delay},
+      max_elapsed_{max_elapsed},
+      attempts_per_server_{attempts_per_server},
+      random_engine_{std::random_device{}()},
+      attempts_{0},
+      first_attempt_time_{} {
+}
+
+
+ObsBackoffReconnectPolicy::~ObsBackoffReconnectPolicy() {
+}
+
+
+void ObsBackoffReconnectPolicy::Reset() {
+  attempts_ = 0;
+}
+
+
+bool ObsBackoffReconnectPolicy::NextAttempt(
+    std::chrono::milliseconds *delay,
+    bool *switches_server) {
+  const std::chrono::steady_clock::time_point now =
+      std::chrono::steady_clock::now();
+  if (attempts_ == 0) {
+    first_attempt_time_ = now;
+  } else if (now - first_attempt_time_ >= max_elapsed_) {
+    return false;
+  }
+
+  static const int kMaxShift{16};
+  const std::chrono::milliseconds ceiling =
+      std::min<std::chrono::milliseconds>(
+          max_delay_,
+          initial_delay_ * (1LL << std::min<int>(attempts_, kMaxShift)));
+  std::uniform_int_distribution<std::chrono::milliseconds::rep>
+      distribution{0, ceiling.count()};
+  *delay = std::chrono::milliseconds{distribution(random_engine_)};
+
+  *switches_server =
+      attempts_ > 0 && attempts_ % attempts_per_server_ == 0;
+  ++attempts_;
+  return true;
+}
+}  // namespace ncstreamer
@@ -0,0 +1,47 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_OBS_OBS_BACKOFF_RECONNECT_POLICY_H_
+#define NCSTREAMER_CEF_SRC_OBS_OBS_BACKOFF_RECONNECT_POLICY_H_
+
+
+#include <chrono>  // NOLINT
+#include <random>
+
+#include "ncstreamer_cef/src/obs/obs_reconnect_policy.h"
+
+
+namespace ncstreamer {
+// Exponential backoff with full jitter: each delay is drawn uniformly from
+// [0, min(max_delay, initial_delay * 2^attempt)], so short blips retry
+// almost at once while long outages back off.
+class ObsBackoffReconnectPolicy : public ObsReconnectPolicy {
+ public:
+  ObsBackoffReconnectPolicy(
+      const std::chrono::milliseconds &initial_delay,
+      const std::chrono::milliseconds &max_delay,
+      const std::chrono::milliseconds &max_elapsed,
+      int attempts_per_server);
+  virtual ~ObsBackoffReconnectPolicy();
+
+  void Reset() override;
+  bool NextAttempt(
+      std::chrono::milliseconds *delay,
+      bool *switches_server) override;
+
+ private:
+  const std::chrono::milliseconds initial_delay_;
+  const std::chrono::milliseconds max_delay_;
+  const std::chrono::milliseconds max_elapsed_;
+  const int attempts_per_server_;
+
+  std::mt19937 random_engine_;
+  int attempts_;
+  std::chrono::steady_clock::time_point first_attempt_time_;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_OBS_OBS_BACKOFF_RECONNECT_POLICY_H_
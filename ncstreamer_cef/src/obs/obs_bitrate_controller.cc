@@ -0,0 +1,180 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/obs/obs_bitrate_controller.h"
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+
+
+namespace ncstreamer {
+ObsBitrateController::ObsBitrateController()
+    : thread_{},
+      stop_cv_{},
+      mutex_{},
+      stops_{false},
+      max_bitrate_{0},
+      bitrate_{0},
+      applied_bitrate_{0},
+      last_dropped_frames_{0},
+      last_total_frames_{0},
+      bad_samples_{0},
+      good_samples_{0},
+      apply_mutex_{},
+      on_bitrate_changed_{} {
+}
+
+
+ObsBitrateController::~ObsBitrateController() {
+  Stop();
+}
+
+
+void ObsBitrateController::Start(
+    const ObsOutput *output,
+    uint32_t max_bitrate,
+    const OnBitrateChanged &on_bitrate_changed) {
+  Stop();
+
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    stops_ = false;
+    max_bitrate_ = max_bitrate;
+    bitrate_ = max_bitrate;
+    applied_bitrate_ = max_bitrate;
+    last_dropped_frames_ = 0;
+    last_total_frames_ = 0;
+    bad_samples_ = 0;
+    good_samples_ = 0;
+  }
+
+  {
+    std::lock_guard<std::mutex> apply_lock{apply_mutex_};
+    on_bitrate_changed_ = on_bitrate_changed;
+  }
+  std::lock_guard<std::mutex> lock{mutex_};
+  thread_ = std::thread{&ObsBitrateController::Run, this, output};
+}
+
+
+void ObsBitrateController::Stop() {
+  // called from both StopStreaming and the output's stop callback.
+  std::thread thread;
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    stops_ = true;
+    thread.swap(thread_);
+  }
+  if (thread.joinable() == false) {
+    return;
+  }
+  stop_cv_.notify_all();
+  thread.join();
+
+  std::lock_guard<std::mutex> apply_lock{apply_mutex_};
+  on_bitrate_changed_ = nullptr;
+}
+
+
+void ObsBitrateController::UpdateMaxBitrate(uint32_t max_bitrate) {
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    max_bitrate_ = max_bitrate;
+    bitrate_ = max_bitrate;
+    bad_samples_ = 0;
+    good_samples_ = 0;
+  }
+  Apply();
+}
+
+
+void ObsBitrateController::Run(const ObsOutput *output) {
+  static const std::chrono::seconds kSampleInterval{1};
+
+  std::unique_lock<std::mutex> lock{mutex_};
+  while (stop_cv_.wait_for(lock, kSampleInterval, [this]() {
+    return stops_;
+  }) == false) {
+    const uint32_t prev_bitrate = bitrate_;
+    const uint32_t bitrate = Sample(output);
+    if (bitrate == prev_bitrate) {
+      continue;
+    }
+
+    lock.unlock();
+    Apply();
+    lock.lock();
+  }
+}
+
+
+uint32_t ObsBitrateController::Sample(const ObsOutput *output) {
+  static const float kCongestedLevel{0.5f};
+  static const float kClearLevel{0.1f};
+  static const double kDroppedRatioLimit{0.02};
+  static const int kStepDownSamples{2};
+  static const int kStepUpSamples{10};
+  static const uint32_t kMinBitrate{300};
+
+  if (output->IsReconnecting() == true) {
+    bad_samples_ = 0;
+    good_samples_ = 0;
+    return bitrate_;
+  }
+
+  const float congestion = output->GetCongestion();
+  const int dropped_frames = output->GetDroppedFrames();
+  const int total_frames = output->GetTotalFrames();
+
+  const int dropped = dropped_frames - last_dropped_frames_;
+  const int total = total_frames - last_total_frames_;
+  last_dropped_frames_ = dropped_frames;
+  last_total_frames_ = total_frames;
+
+  const double dropped_ratio =
+      (total > 0) ? static_cast<double>(dropped) / total : 0.0;
+
+  if (congestion > kCongestedLevel || dropped_ratio > kDroppedRatioLimit) {
+    ++bad_samples_;
+    good_samples_ = 0;
+  } else if (congestion < kClearLevel && dropped == 0) {
+    ++good_samples_;
+    bad_samples_ = 0;
+  } else {
+    bad_samples_ = 0;
+    good_samples_ = 0;
+  }
+
+  const uint32_t min_bitrate = std::min(
+      max_bitrate_, std::max(kMinBitrate, max_bitrate_ / 4));
+  if (bad_samples_ >= kStepDownSamples) {
+    bitrate_ = std::max(min_bitrate, bitrate_ * 3 / 4);
+    bad_samples_ = 0;
+  } else if (good_samples_ >= kStepUpSamples) {
+    bitrate_ = std::min(max_bitrate_, bitrate_ + max_bitrate_ / 10);
+    good_samples_ = 0;
+  }
+  return bitrate_;
+}
+
+
+void ObsBitrateController::Apply() {
+  std::lock_guard<std::mutex> apply_lock{apply_mutex_};
+  if (!on_bitrate_changed_) {
+    return;
+  }
+
+  uint32_t bitrate{0};
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (bitrate_ == applied_bitrate_) {
+      return;
+    }
+    bitrate = bitrate_;
+    applied_bitrate_ = bitrate_;
+  }
+  on_bitrate_changed_(bitrate);
+}
+}  // namespace ncstreamer
@@ -0,0 +1,64 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_OBS_OBS_BITRATE_CONTROLLER_H_
+#define NCSTREAMER_CEF_SRC_OBS_OBS_BITRATE_CONTROLLER_H_
+
+
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <functional>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+
+#include "ncstreamer_cef/src/obs/obs_output.h"
+
+
+namespace ncstreamer {
+class ObsBitrateController {
+ public:
+  using OnBitrateChanged = std::function<void(uint32_t bitrate)>;
+
+  ObsBitrateController();
+  virtual ~ObsBitrateController();
+
+  void Start(
+      const ObsOutput *output,
+      uint32_t max_bitrate,
+      const OnBitrateChanged &on_bitrate_changed);
+  void Stop();
+
+  // applies the new maximum to the encoder through on_bitrate_changed.
+  void UpdateMaxBitrate(uint32_t max_bitrate);
+
+ private:
+  void Run(const ObsOutput *output);
+  uint32_t Sample(const ObsOutput *output);
+  void Apply();
+
+  std::thread thread_;
+  std::condition_variable stop_cv_;
+  // This mutex is used for two purposes:
+  // 1) to synchronize accesses to thread_, stops_ and the bitrates below
+  // 2) for the condition variable stop_cv_
+  mutable std::mutex mutex_;
+  bool stops_;
+
+  uint32_t max_bitrate_;
+  uint32_t bitrate_;
+  uint32_t applied_bitrate_;
+  int last_dropped_frames_;
+  int last_total_frames_;
+  int bad_samples_;
+  int good_samples_;
+
+  // serializes the encoder writes so that the latest bitrate_ lands last.
+  std::mutex apply_mutex_;
+  OnBitrateChanged on_bitrate_changed_;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_OBS_OBS_BITRATE_CONTROLLER_H_
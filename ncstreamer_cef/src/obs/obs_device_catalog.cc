@@ -0,0 +1,204 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/obs/obs_device_catalog.h"
+
+#include "Dbt.h"  // NOLINT
+#include "obs-studio/libobs/obs.h"
+
+#include "ncstreamer_cef/src/obs/obs_source_info.h"
+
+
+namespace ncstreamer {
+ObsDeviceCatalog::ObsDeviceCatalog(
+    Notification notification,
+    const std::string &webcam_source_id,
+    const std::string &mic_source_id)
+    : webcam_source_id_{webcam_source_id},
+      mic_source_id_{mic_source_id},
+      stop_event_{::CreateEvent(NULL, TRUE, FALSE, NULL)},
+      thread_{},
+      stale_{true},
+      mutex_{},
+      generation_{0},
+      webcams_{},
+      webcam_ids_{},
+      mics_{} {
+  if (notification == Notification::kPolling) {
+    thread_ = std::thread{&ObsDeviceCatalog::PollDeviceChanges, this};
+  } else {
+    thread_ = std::thread{&ObsDeviceCatalog::WatchDeviceChanges, this};
+  }
+}
+
+
+ObsDeviceCatalog::~ObsDeviceCatalog() {
+  ::SetEvent(stop_event_);
+  thread_.join();
+  ::CloseHandle(stop_event_);
+}
+
+
+std::vector<std::string> ObsDeviceCatalog::GetWebcams() {
+  Refresh();
+  std::lock_guard<std::mutex> lock{mutex_};
+  return webcams_;
+}
+
+
+ObsDeviceCatalog::MicMap ObsDeviceCatalog::GetMics() {
+  Refresh();
+  std::lock_guard<std::mutex> lock{mutex_};
+  return mics_;
+}
+
+
+bool ObsDeviceCatalog::HasWebcam(const std::string &device_id) {
+  Refresh();
+  std::lock_guard<std::mutex> lock{mutex_};
+  return webcam_ids_.find(device_id) != webcam_ids_.end();
+}
+
+
+bool ObsDeviceCatalog::HasMic(const std::string &device_id) {
+  Refresh();
+  std::lock_guard<std::mutex> lock{mutex_};
+  return mics_.find(device_id) != mics_.end();
+}
+
+
+void ObsDeviceCatalog::Invalidate() {
+  stale_ = true;
+}
+
+
+uint64_t ObsDeviceCatalog::generation() {
+  Refresh();
+  std::lock_guard<std::mutex> lock{mutex_};
+  return generation_;
+}
+
+
+LRESULT CALLBACK ObsDeviceCatalog::WindowProc(
+    HWND wnd, UINT msg, WPARAM wparam, LPARAM lparam) {
+  if (msg == WM_DEVICECHANGE &&
+      (wparam == DBT_DEVICEARRIVAL || wparam == DBT_DEVICEREMOVECOMPLETE)) {
+    auto self = reinterpret_cast<ObsDeviceCatalog *>(
+        ::GetWindowLongPtr(wnd, GWLP_USERDATA));
+    if (self) {
+      self->Invalidate();
+    }
+    return TRUE;
+  }
+  return ::DefWindowProc(wnd, msg, wparam, lparam);
+}
+
+
+std::vector<std::string> ObsDeviceCatalog::EnumerateWebcams() const {
+  std::vector<std::string> webcams;
+
+  obs_source_t *source = obs_source_create(
+      webcam_source_id_.c_str(), "VideoCaptureDevice", nullptr, nullptr);
+  obs_properties_t *props = obs_source_properties(source);
+  obs_property_t *prop = obs_properties_get(props, "video_device_id");
+
+  size_t count = obs_property_list_item_count(prop);
+  for (size_t i = 0; i < count; i++) {
+    const char *val = obs_property_list_item_string(prop, i);
+    if (strlen(val) != 0) {
+      webcams.emplace_back(ObsSourceInfo::Decode(val));
+    }
+  }
+
+  obs_properties_destroy(props);
+  obs_source_release(source);
+  return webcams;
+}
+
+
+ObsDeviceCatalog::MicMap ObsDeviceCatalog::EnumerateMics() const {
+  obs_properties_t *input_props = obs_get_source_properties(
+      mic_source_id_.c_str());
+  obs_property_t *prop = obs_properties_get(
+      input_props, "device_id");
+  size_t count = obs_property_list_item_count(prop);
+  MicMap mics;
+  for (size_t i = 0; i < count; i++) {
+    const char *val = obs_property_list_item_string(prop, i);
+    const char *name = obs_property_list_item_name(prop, i);
+    mics.emplace(val, name);
+  }
+  obs_properties_destroy(input_props);
+  return mics;
+}
+
+
+void ObsDeviceCatalog::WatchDeviceChanges() {
+  static const wchar_t *kClassName{L"NCStreamerDeviceCatalog"};
+
+  HINSTANCE instance = ::GetModuleHandle(NULL);
+  WNDCLASSEXW wc{};
+  wc.cbSize = sizeof(wc);
+  wc.lpfnWndProc = ObsDeviceCatalog::WindowProc;
+  wc.hInstance = instance;
+  wc.lpszClassName = kClassName;
+  ::RegisterClassExW(&wc);
+
+  HWND wnd = ::CreateWindowExW(0, kClassName, L"", 0, 0, 0, 0, 0,
+                               HWND_MESSAGE, NULL, instance, NULL);
+  ::SetWindowLongPtr(wnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(this));
+
+  DEV_BROADCAST_DEVICEINTERFACE_W filter{};
+  filter.dbcc_size = sizeof(filter);
+  filter.dbcc_devicetype = DBT_DEVTYP_DEVICEINTERFACE;
+  HDEVNOTIFY notify = ::RegisterDeviceNotificationW(
+      wnd, &filter,
+      DEVICE_NOTIFY_WINDOW_HANDLE | DEVICE_NOTIFY_ALL_INTERFACE_CLASSES);
+
+  while (::MsgWaitForMultipleObjects(
+      1, &stop_event_, FALSE, INFINITE, QS_ALLINPUT) != WAIT_OBJECT_0) {
+    MSG msg;
+    while (::PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
+      ::TranslateMessage(&msg);
+      ::DispatchMessage(&msg);
+    }
+  }
+
+  if (notify) {
+    ::UnregisterDeviceNotification(notify);
+  }
+  ::DestroyWindow(wnd);
+  ::UnregisterClassW(kClassName, instance);
+}
+
+
+void ObsDeviceCatalog::PollDeviceChanges() {
+  static const DWORD kPollInterval{3000};
+
+  while (::WaitForSingleObject(stop_event_, kPollInterval) == WAIT_TIMEOUT) {
+    Invalidate();
+  }
+}
+
+
+void ObsDeviceCatalog::Refresh() {
+  if (stale_.exchange(false) == false) {
+    return;
+  }
+
+  std::vector<std::string> webcams = EnumerateWebcams();
+  MicMap mics = EnumerateMics();
+
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (webcams == webcams_ && mics == mics_) {
+    return;
+  }
+  webcams_.swap(webcams);
+  webcam_ids_.clear();
+  webcam_ids_.insert(webcams_.begin(), webcams_.end());
+  mics_.swap(mics);
+  ++generation_;
+}
+}  // namespace ncstreamer
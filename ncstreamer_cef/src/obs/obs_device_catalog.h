@@ -0,0 +1,77 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_OBS_OBS_DEVICE_CATALOG_H_
+#define NCSTREAMER_CEF_SRC_OBS_OBS_DEVICE_CATALOG_H_
+
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "windows.h"  // NOLINT
+
+
+namespace ncstreamer {
+class ObsDeviceCatalog {
+ public:
+  using MicMap =
+      std::unordered_map<std::string /*id*/, std::string /*name*/>;
+
+  enum class Notification {
+    kDeviceChange,
+    // for environments without a message loop for WM_DEVICECHANGE.
+    kPolling,
+  };
+
+  // the source ids are the backend's webcam and mic source types.
+  ObsDeviceCatalog(
+      Notification notification,
+      const std::string &webcam_source_id,
+      const std::string &mic_source_id);
+  virtual ~ObsDeviceCatalog();
+
+  std::vector<std::string> GetWebcams();
+  MicMap GetMics();
+  bool HasWebcam(const std::string &device_id);
+  bool HasMic(const std::string &device_id);
+
+  // the next lookup enumerates the devices again.
+  void Invalidate();
+  uint64_t generation();
+
+ private:
+  static LRESULT CALLBACK WindowProc(
+      HWND wnd, UINT msg, WPARAM wparam, LPARAM lparam);
+
+  std::vector<std::string> EnumerateWebcams() const;
+  MicMap EnumerateMics() const;
+
+  void WatchDeviceChanges();
+  void PollDeviceChanges();
+  void Refresh();
+
+  const std::string webcam_source_id_;
+  const std::string mic_source_id_;
+
+  HANDLE stop_event_;
+  std::thread thread_;
+  std::atomic<bool> stale_;
+
+  std::mutex mutex_;
+  uint64_t generation_;
+  std::vector<std::string> webcams_;
+  std::unordered_set<std::string> webcam_ids_;
+  MicMap mics_;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_OBS_OBS_DEVICE_CATALOG_H_
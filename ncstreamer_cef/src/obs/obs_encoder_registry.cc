@@ -0,0 +1,152 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/obs/obs_encoder_registry.h"
+
+#include <algorithm>
+#include <sstream>
+#include <thread>  // NOLINT
+
+#include "obs-studio/libobs/obs.h"
+
+#include "ncstreamer_cef/src/local_storage.h"
+
+
+namespace ncstreamer {
+ObsEncoderRegistry::ObsEncoderRegistry()
+    : available_encoders_{EnumerateEncoders()},
+      video_encoder_id_{FindEncoder({"obs_x264"})},
+      audio_encoder_id_{FindEncoder({"ffmpeg_aac", "mf_aac"})} {
+}
+
+
+ObsEncoderRegistry::~ObsEncoderRegistry() {
+}
+
+
+std::string ObsEncoderRegistry::SelectPreset(
+    const Dimension<uint32_t> &output_size,
+    uint32_t fps) const {
+  const std::string &measured = LocalStorage::Get()->GetEncoderPreset(
+      ToModeKey(output_size, fps));
+  if (measured.empty() == false) {
+    return measured;
+  }
+  return EstimatePreset(output_size, fps);
+}
+
+
+void ObsEncoderRegistry::RecordSession(
+    const Dimension<uint32_t> &output_size,
+    uint32_t fps,
+    const std::string &preset,
+    uint32_t skipped_frames,
+    uint32_t total_frames) {
+  static const uint32_t kMinTotalFrames{300};
+  if (total_frames < kMinTotalFrames) {
+    return;
+  }
+
+  static const double kSkippedRatioLimit{0.01};
+  // a load that was only temporary should not cost quality for good.
+  static const int kCleanSessionsToSlowDown{5};
+
+  const std::string &mode = ToModeKey(output_size, fps);
+  const double skipped_ratio =
+      static_cast<double>(skipped_frames) / total_frames;
+  if (skipped_ratio > kSkippedRatioLimit) {
+    LocalStorage::Get()->SetEncoderPreset(mode, FasterPreset(preset));
+    LocalStorage::Get()->SetEncoderCleanSessions(mode, 0);
+    return;
+  }
+
+  const int clean_sessions =
+      LocalStorage::Get()->GetEncoderCleanSessions(mode) + 1;
+  if (clean_sessions < kCleanSessionsToSlowDown) {
+    LocalStorage::Get()->SetEncoderPreset(mode, preset);
+    LocalStorage::Get()->SetEncoderCleanSessions(mode, clean_sessions);
+    return;
+  }
+  LocalStorage::Get()->SetEncoderPreset(mode, SlowerPreset(preset));
+  LocalStorage::Get()->SetEncoderCleanSessions(mode, 0);
+}
+
+
+std::unordered_set<std::string> ObsEncoderRegistry::EnumerateEncoders() {
+  std::unordered_set<std::string> encoders;
+  const char *id{nullptr};
+  for (std::size_t i = 0; obs_enum_encoder_types(i, &id); ++i) {
+    encoders.emplace(id);
+  }
+  return encoders;
+}
+
+
+std::string ObsEncoderRegistry::ToModeKey(
+    const Dimension<uint32_t> &output_size,
+    uint32_t fps) {
+  std::stringstream ss;
+  ss << output_size.width() << "x" << output_size.height() << "@" << fps;
+  return ss.str();
+}
+
+
+std::string ObsEncoderRegistry::EstimatePreset(
+    const Dimension<uint32_t> &output_size,
+    uint32_t fps) {
+  // pixels per second one core encodes with the veryfast preset.
+  static const uint64_t kVeryFastPixelRate{1280 * 720 * 15};
+
+  const uint64_t pixel_rate =
+      static_cast<uint64_t>(output_size.width()) * output_size.height() * fps;
+  // leave at least half of the cores to the game.
+  const uint64_t encoder_cores =
+      std::max(1u, std::thread::hardware_concurrency() / 2);
+
+  if (pixel_rate <= encoder_cores * kVeryFastPixelRate) {
+    return "veryfast";
+  }
+  if (pixel_rate <= encoder_cores * kVeryFastPixelRate * 8 / 5) {
+    return "superfast";
+  }
+  return "ultrafast";
+}
+
+
+std::string ObsEncoderRegistry::FasterPreset(const std::string &preset) {
+  static const std::vector<std::string> kPresets{
+      "medium", "fast", "faster", "veryfast", "superfast", "ultrafast"};
+
+  auto i = std::find(kPresets.begin(), kPresets.end(), preset);
+  if (i == kPresets.end() || i + 1 == kPresets.end()) {
+    return kPresets.back();
+  }
+  return *(i + 1);
+}
+
+
+std::string ObsEncoderRegistry::SlowerPreset(const std::string &preset) {
+  // slower presets than veryfast take more CPU than a game can spare.
+  static const std::vector<std::string> kPresets{
+      "veryfast", "superfast", "ultrafast"};
+
+  auto i = std::find(kPresets.begin(), kPresets.end(), preset);
+  if (i == kPresets.end() || i == kPresets.begin()) {
+    return preset;
+  }
+  return *(i - 1);
+}
+
+
+std::string ObsEncoderRegistry::FindEncoder(
+    const std::vector<std::string> &chain) const {
+  for (const auto &id : chain) {
+    if (available_encoders_.find(id) != available_encoders_.end()) {
+      return id;
+    }
+  }
+  return "";
+}
+}  // namespace ncstreamer
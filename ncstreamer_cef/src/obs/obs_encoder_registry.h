@@ -0,0 +1,59 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_OBS_OBS_ENCODER_REGISTRY_H_
+#define NCSTREAMER_CEF_SRC_OBS_OBS_ENCODER_REGISTRY_H_
+
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "ncstreamer_cef/src/lib/dimension.h"
+
+
+namespace ncstreamer {
+class ObsEncoderRegistry {
+ public:
+  ObsEncoderRegistry();
+  virtual ~ObsEncoderRegistry();
+
+  const std::string &video_encoder_id() const { return video_encoder_id_; }
+  const std::string &audio_encoder_id() const { return audio_encoder_id_; }
+
+  std::string SelectPreset(
+      const Dimension<uint32_t> &output_size,
+      uint32_t fps) const;
+
+  void RecordSession(
+      const Dimension<uint32_t> &output_size,
+      uint32_t fps,
+      const std::string &preset,
+      uint32_t skipped_frames,
+      uint32_t total_frames);
+
+ private:
+  static std::unordered_set<std::string> EnumerateEncoders();
+  static std::string ToModeKey(
+      const Dimension<uint32_t> &output_size,
+      uint32_t fps);
+  static std::string EstimatePreset(
+      const Dimension<uint32_t> &output_size,
+      uint32_t fps);
+  static std::string FasterPreset(const std::string &preset);
+  static std::string SlowerPreset(const std::string &preset);
+
+  // empty if no encoder in the chain is available.
+  std::string FindEncoder(const std::vector<std::string> &chain) const;
+
+  const std::unordered_set<std::string> available_encoders_;
+  const std::string video_encoder_id_;
+  const std::string audio_encoder_id_;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_OBS_OBS_ENCODER_REGISTRY_H_
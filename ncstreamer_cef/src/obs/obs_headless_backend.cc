@@ -0,0 +1,84 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/obs/obs_headless_backend.h"
+
+
+namespace ncstreamer {
+ObsHeadlessBackend::ObsHeadlessBackend() {
+}
+
+
+ObsHeadlessBackend::~ObsHeadlessBackend() {
+}
+
+
+const char *ObsHeadlessBackend::graphics_module() const {
+  // libobs appends the platform's library extension.
+  return "libobs-opengl";
+}
+
+
+const std::unordered_set<std::string> &ObsHeadlessBackend::modules() const {
+  static const std::unordered_set<std::string> kModules{
+      "test-input",
+      "obs-x264",
+      "obs-ffmpeg",
+      "obs-outputs",
+      "rtmp-services",
+      "obs-filters",
+      "obs-transitions",
+      "image-source",
+      "text-freetype2"};
+  return kModules;
+}
+
+
+ObsDeviceCatalog::Notification
+    ObsHeadlessBackend::device_notification() const {
+  return ObsDeviceCatalog::Notification::kPolling;
+}
+
+
+const char *ObsHeadlessBackend::game_source_id() const {
+  return "random";
+}
+
+
+const char *ObsHeadlessBackend::webcam_source_id() const {
+  return "random";
+}
+
+
+const char *ObsHeadlessBackend::mic_source_id() const {
+  return "test_sinewave";
+}
+
+
+const char *ObsHeadlessBackend::desktop_audio_source_id() const {
+  return "test_sinewave";
+}
+
+
+const char *ObsHeadlessBackend::image_source_id() const {
+  return "image_source";
+}
+
+
+const char *ObsHeadlessBackend::text_source_id() const {
+  return "text_ft2_source";
+}
+
+
+Dimension<uint32_t> ObsHeadlessBackend::GetSourceSize(
+    const std::string & /*source_info*/, obs_source_t *source) const {
+  // the synthetic source has no window; its own size stands in for it.
+  if (!source) {
+    return Dimension<uint32_t>{0, 0};
+  }
+  return Dimension<uint32_t>{obs_source_get_width(source),
+                             obs_source_get_height(source)};
+}
+}  // namespace ncstreamer
@@ -0,0 +1,44 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_OBS_OBS_HEADLESS_BACKEND_H_
+#define NCSTREAMER_CEF_SRC_OBS_OBS_HEADLESS_BACKEND_H_
+
+
+#include <string>
+#include <unordered_set>
+
+#include "ncstreamer_cef/src/obs/obs_backend.h"
+
+
+namespace ncstreamer {
+// Offscreen OpenGL with the synthetic sources of the test-input module, so
+// the pipeline runs without a game or capture devices. Streams go wherever
+// the service points, e.g. a loopback RTMP server.
+// Windows only: the device catalog, the window index and the resolution
+// watcher under Obs still call Win32; they find nothing here.
+class ObsHeadlessBackend : public ObsBackend {
+ public:
+  ObsHeadlessBackend();
+  virtual ~ObsHeadlessBackend();
+
+  const char *graphics_module() const override;
+  const std::unordered_set<std::string> &modules() const override;
+  ObsDeviceCatalog::Notification device_notification() const override;
+
+  const char *game_source_id() const override;
+  const char *webcam_source_id() const override;
+  const char *mic_source_id() const override;
+  const char *desktop_audio_source_id() const override;
+  const char *image_source_id() const override;
+  const char *text_source_id() const override;
+
+  Dimension<uint32_t> GetSourceSize(
+      const std::string &source_info, obs_source_t *source) const override;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_OBS_OBS_HEADLESS_BACKEND_H_
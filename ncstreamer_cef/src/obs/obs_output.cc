@@ -5,78 +5,499 @@
 
 #include "ncstreamer_cef/src/obs/obs_output.h"
 
+#include <utility>
+
+#include "ncstreamer_cef/src/obs/obs_backoff_reconnect_policy.h"
+
 
 namespace ncstreamer {
-ObsOutput::ObsOutput()
-    : output_{obs_output_create(
-          "rtmp_output", "simple_stream", nullptr, nullptr)},
+ObsOutput::ObsOutput(const std::string &name)
+    : name_{name},
+      output_{obs_output_create(
+          "rtmp_output", name.c_str(), nullptr, nullptr)},
+      service_{nullptr},
       signal_handler_{obs_output_get_signal_handler(output_)},
+      stop_watcher_{},
+      reconnector_{},
+      state_cv_{},
+      mutex_{},
+      state_{State::kIdle},
+      quits_{false},
       on_started_{},
-      on_stopped_{} {
+      on_stopped_{},
+      on_reconnecting_{},
+      on_recovered_{},
+      service_provider_{},
+      stream_key_{},
+      stream_servers_{},
+      server_index_{0},
+      reconnect_policy_{new ObsBackoffReconnectPolicy{
+          std::chrono::seconds{1},
+          std::chrono::seconds{30},
+          std::chrono::minutes{5},
+          /*attempts_per_server*/ 3}},
+      has_been_live_{false},
+      reconnect_attempts_{0} {
   obs_data_t *settings = obs_data_create();
   obs_data_set_string(settings, "bind_ip", "default");
   obs_output_update(output_, settings);
   obs_data_release(settings);
 
-  obs_output_set_delay(output_, 0, OBS_OUTPUT_DELAY_PRESERVE);
+  SetDelay(0);
+  // reconnecting is driven by reconnect_policy_, not by libobs.
   obs_output_set_reconnect_settings(
-      output_, /*max_retries*/ 20, /*retry_delay*/ 10);
+      output_, /*max_retries*/ 0, /*retry_delay*/ 0);
+
+  signal_handler_connect(signal_handler_, "start", OnStartSignal, this);
+  signal_handler_connect(signal_handler_, "stop", OnStopSignal, this);
+
+  reconnector_ = std::thread{&ObsOutput::Reconnect, this};
 }
 
 
 ObsOutput::~ObsOutput() {
-  on_stopped_.reset();
-  on_started_.reset();
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    quits_ = true;
+  }
+  state_cv_.notify_all();
+  reconnector_.join();
+
+  WaitForStop();
+  signal_handler_disconnect(signal_handler_, "stop", OnStopSignal, this);
+  signal_handler_disconnect(signal_handler_, "start", OnStartSignal, this);
 
   obs_output_release(output_);
   output_ = nullptr;
+
+  ReleaseService();
+}
+
+
+void ObsOutput::UpdateService(
+    const std::string &service_provider,
+    const std::string &stream_server,
+    const std::string &stream_key,
+    const std::vector<std::string> &fallback_servers) {
+  obs_data_t *settings = obs_data_create();
+  obs_data_set_string(settings, "service", service_provider.c_str());
+  obs_data_set_string(settings, "server", stream_server.c_str());
+  obs_data_set_string(settings, "key", stream_key.c_str());
+  obs_data_set_bool(settings, "show_all", false);
+
+  const std::string &service_name = name_ + "_service";
+  obs_service_t *service = obs_service_create(
+      "rtmp_common", service_name.c_str(), settings, nullptr);
+  obs_data_release(settings);
+
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (service_) {
+    obs_service_release(service_);
+  }
+  service_ = service;
+  service_provider_ = service_provider;
+  stream_key_ = stream_key;
+  stream_servers_.clear();
+  stream_servers_.emplace_back(stream_server);
+  stream_servers_.insert(stream_servers_.end(),
+      fallback_servers.begin(), fallback_servers.end());
+  server_index_ = 0;
+}
+
+
+void ObsOutput::SetDelay(uint32_t delay_sec) {
+  // a reconnect keeps what is already buffered.
+  obs_output_set_delay(output_, delay_sec, OBS_OUTPUT_DELAY_PRESERVE);
+}
+
+
+void ObsOutput::SetReconnectPolicy(
+    std::unique_ptr<ObsReconnectPolicy> policy) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  reconnect_policy_ = std::move(policy);
+}
+
+
+void ObsOutput::SetReconnectHandlers(
+    const OnReconnecting &on_reconnecting,
+    const OnRecovered &on_recovered) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  on_reconnecting_ = on_reconnecting;
+  on_recovered_ = on_recovered;
 }
 
 
 bool ObsOutput::Start(obs_encoder_t *audio_encoder,
                       obs_encoder_t *video_encoder,
-                      obs_service_t *service,
                       const OnStarted &on_started,
-                      const OnStopped &on_timeout) {
+                      const OnStopped &on_stopped) {
+  const std::shared_ptr<obs_service_t> &service = this->service();
+  if (!service || IsStopping() == true) {
+    return false;
+  }
+  // only joins a watcher that is about to exit.
+  WaitForStop();
+
   obs_output_set_audio_encoder(output_, audio_encoder, 0);
   obs_output_set_video_encoder(output_, video_encoder);
-  obs_output_set_service(output_, service);
-
-  signal_handler_disconnect(
-      signal_handler_, "start", OnStartSignal, on_started_.get());
-  on_started_.reset(new OnStarted{on_started});
-  signal_handler_connect(
-      signal_handler_, "start", OnStartSignal, on_started_.get());
+  obs_output_set_service(output_, service.get());
 
-  signal_handler_disconnect(
-      signal_handler_, "stop", OnStopSignal, on_stopped_.get());
-  on_stopped_.reset(new OnStopped{on_timeout});
-  signal_handler_connect(
-      signal_handler_, "stop", OnStopSignal, on_stopped_.get());
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    state_ = State::kActive;
+    on_started_ = on_started;
+    on_stopped_ = on_stopped;
+    has_been_live_ = false;
+    reconnect_attempts_ = 0;
+    reconnect_policy_->Reset();
+  }
 
-  return obs_output_start(output_);
+  if (obs_output_start(output_) == false) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    state_ = State::kIdle;
+    on_started_ = nullptr;
+    on_stopped_ = nullptr;
+    return false;
+  }
+  return true;
 }
 
 
-void ObsOutput::Stop(const OnStopped &on_stopped) {
-  signal_handler_disconnect(
-      signal_handler_, "stop", OnStopSignal, on_stopped_.get());
-  on_stopped_.reset(new OnStopped{on_stopped});
-  signal_handler_connect(
-      signal_handler_, "stop", OnStopSignal, on_stopped_.get());
+void ObsOutput::Stop(const OnStopped &on_stopped,
+                     const std::chrono::milliseconds &drain_timeout) {
+  std::unique_lock<std::mutex> lock{mutex_};
+  switch (state_) {
+  case State::kActive:
+  case State::kStarting:
+    state_ = State::kStopping;
+    on_started_ = nullptr;
+    on_stopped_ = on_stopped;
+    break;
+  case State::kStopping:
+  case State::kForceStopping:
+  case State::kFinishing: {
+    OnStopped prev_on_stopped = on_stopped_;
+    on_stopped_ = [prev_on_stopped, on_stopped](StopReason reason) {
+      if (prev_on_stopped) {
+        prev_on_stopped(reason);
+      }
+      on_stopped(reason);
+    };
+    return;
+  }
+  case State::kReconnecting:
+    // nothing is running; only the pending attempt is called off.
+    on_stopped_ = on_stopped;
+    lock.unlock();
+    FinishStop(StopReason::kUser);
+    return;
+  default:
+    lock.unlock();
+    on_stopped(StopReason::kUser);
+    return;
+  }
+  lock.unlock();
 
+  if (stop_watcher_.joinable() == true) {
+    stop_watcher_.join();
+  }
+  stop_watcher_ = std::thread{&ObsOutput::WatchStop, this, drain_timeout};
   obs_output_stop(output_);
 }
 
 
+void ObsOutput::WaitForStop() {
+  if (stop_watcher_.joinable() == true) {
+    stop_watcher_.join();
+  }
+  std::unique_lock<std::mutex> lock{mutex_};
+  state_cv_.wait(lock, [this]() {
+    return state_ == State::kIdle ||
+           state_ == State::kActive ||
+           state_ == State::kReconnecting ||
+           state_ == State::kStarting;
+  });
+}
+
+
+bool ObsOutput::IsActive() const {
+  // libobs reports inactive between reconnect attempts.
+  std::lock_guard<std::mutex> lock{mutex_};
+  return state_ == State::kActive ||
+         state_ == State::kStarting ||
+         state_ == State::kReconnecting;
+}
+
+
+bool ObsOutput::IsStopping() const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  return state_ == State::kStopping ||
+         state_ == State::kForceStopping ||
+         state_ == State::kFinishing;
+}
+
+
+bool ObsOutput::IsReconnecting() const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  return state_ == State::kReconnecting || reconnect_attempts_ > 0;
+}
+
+
+uint32_t ObsOutput::GetActiveDelay() const {
+  return obs_output_get_active_delay(output_);
+}
+
+
+float ObsOutput::GetCongestion() const {
+  return obs_output_get_congestion(output_);
+}
+
+
+int ObsOutput::GetDroppedFrames() const {
+  return obs_output_get_frames_dropped(output_);
+}
+
+
+int ObsOutput::GetTotalFrames() const {
+  return obs_output_get_total_frames(output_);
+}
+
+
+uint64_t ObsOutput::GetTotalBytes() const {
+  return obs_output_get_total_bytes(output_);
+}
+
+
 void ObsOutput::OnStartSignal(void *data, calldata_t * /*params*/) {
-  auto on_started = reinterpret_cast<OnStarted *>(data);
-  (*on_started)();
+  auto self = reinterpret_cast<ObsOutput *>(data);
+
+  OnStarted on_started;
+  OnRecovered on_recovered;
+  int attempts{0};
+  std::string stream_server;
+  {
+    std::lock_guard<std::mutex> lock{self->mutex_};
+    on_started.swap(self->on_started_);
+    self->has_been_live_ = true;
+    if (self->reconnect_attempts_ > 0) {
+      on_recovered = self->on_recovered_;
+      attempts = self->reconnect_attempts_;
+      stream_server = self->stream_servers_[self->server_index_];
+      self->reconnect_attempts_ = 0;
+      self->reconnect_policy_->Reset();
+    }
+  }
+  if (on_started) {
+    on_started();
+  }
+  if (on_recovered) {
+    on_recovered(attempts, stream_server);
+  }
+}
+
+
+void ObsOutput::OnStopSignal(void *data, calldata_t *params) {
+  auto self = reinterpret_cast<ObsOutput *>(data);
+  const long long code = calldata_int(params, "code");  // NOLINT
+
+  StopReason reason{StopReason::kUser};
+  {
+    std::lock_guard<std::mutex> lock{self->mutex_};
+    switch (self->state_) {
+    case State::kActive:
+    case State::kStarting:
+      if (self->has_been_live_ == true && IsRetryable(code) == true) {
+        self->state_ = State::kReconnecting;
+        self->state_cv_.notify_all();
+        return;
+      }
+      reason = (code == OBS_OUTPUT_SUCCESS) ?
+          StopReason::kRemote : StopReason::kNetwork;
+      break;
+    case State::kStopping:
+      reason = StopReason::kUser;
+      break;
+    case State::kForceStopping:
+      reason = StopReason::kTimeout;
+      break;
+    default:
+      return;
+    }
+  }
+  self->FinishStop(reason);
+}
+
+
+bool ObsOutput::IsRetryable(long long code) {  // NOLINT
+  return code == OBS_OUTPUT_CONNECT_FAILED ||
+         code == OBS_OUTPUT_DISCONNECTED ||
+         code == OBS_OUTPUT_ERROR;
+}
+
+
+void ObsOutput::WatchStop(const std::chrono::milliseconds &drain_timeout) {
+  static const std::chrono::seconds kForceStopTimeout{2};
+  auto is_stopped = [this]() {
+    return state_ == State::kFinishing || state_ == State::kIdle;
+  };
+
+  std::unique_lock<std::mutex> lock{mutex_};
+  if (state_cv_.wait_for(lock, drain_timeout, is_stopped) == false) {
+    state_ = State::kForceStopping;
+    lock.unlock();
+    obs_output_force_stop(output_);
+    lock.lock();
+
+    if (state_cv_.wait_for(lock, kForceStopTimeout, is_stopped) == false) {
+      // libobs never signaled the stop; report it ourselves.
+      lock.unlock();
+      FinishStop(StopReason::kTimeout);
+    }
+  }
+}
+
+
+void ObsOutput::FinishStop(StopReason reason) {
+  OnStopped on_stopped;
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (state_ == State::kFinishing || state_ == State::kIdle) {
+      return;
+    }
+    state_ = State::kFinishing;
+    on_started_ = nullptr;
+    on_stopped.swap(on_stopped_);
+  }
+  state_cv_.notify_all();
+
+  if (on_stopped) {
+    on_stopped(reason);
+  }
+
+  // a Stop() from within on_stopped is chained onto on_stopped_.
+  OnStopped late_on_stopped;
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    late_on_stopped.swap(on_stopped_);
+    state_ = State::kIdle;
+  }
+  state_cv_.notify_all();
+
+  if (late_on_stopped) {
+    late_on_stopped(reason);
+  }
+}
+
+
+void ObsOutput::Reconnect() {
+  std::unique_lock<std::mutex> lock{mutex_};
+  while (true) {
+    state_cv_.wait(lock, [this]() {
+      return quits_ || state_ == State::kReconnecting;
+    });
+    if (quits_ == true) {
+      return;
+    }
+
+    std::chrono::milliseconds delay{0};
+    bool switches_server{false};
+    if (reconnect_policy_->NextAttempt(&delay, &switches_server) == false) {
+      lock.unlock();
+      FinishStop(StopReason::kNetwork);
+      lock.lock();
+      continue;
+    }
+    const std::size_t prev_server_index = server_index_;
+    if (switches_server == true) {
+      server_index_ = (server_index_ + 1) % stream_servers_.size();
+    }
+    const bool server_switched = (server_index_ != prev_server_index);
+    const std::string stream_server = stream_servers_[server_index_];
+    const int attempt = ++reconnect_attempts_;
+    OnReconnecting on_reconnecting = on_reconnecting_;
+
+    lock.unlock();
+    if (on_reconnecting) {
+      on_reconnecting(attempt, delay, stream_server);
+    }
+    lock.lock();
+
+    if (state_cv_.wait_for(lock, delay, [this]() {
+      return quits_ || state_ != State::kReconnecting;
+    }) == true) {
+      continue;
+    }
+    state_ = State::kStarting;
+    lock.unlock();
+
+    if (server_switched == true) {
+      UpdateServiceServer(stream_server);
+    }
+    const bool started = obs_output_start(output_);
+
+    lock.lock();
+    if (state_ == State::kStarting) {
+      state_ = (started == true) ? State::kActive : State::kReconnecting;
+      continue;
+    }
+    if (state_ != State::kStopping && state_ != State::kForceStopping) {
+      continue;  // the stop signal got here first.
+    }
+
+    // a Stop() came in while starting; its obs_output_stop may have been
+    // too early to take effect.
+    lock.unlock();
+    if (started == true) {
+      obs_output_stop(output_);
+    } else {
+      FinishStop(StopReason::kUser);
+    }
+    lock.lock();
+  }
+}
+
+
+std::shared_ptr<obs_service_t> ObsOutput::service() const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (!service_) {
+    return nullptr;
+  }
+  obs_service_addref(service_);
+  return std::shared_ptr<obs_service_t>{service_, obs_service_release};
+}
+
+
+void ObsOutput::UpdateServiceServer(const std::string &stream_server) {
+  std::string service_provider;
+  std::string stream_key;
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    service_provider = service_provider_;
+    stream_key = stream_key_;
+  }
+  // UpdateService() or ReleaseService() may drop service_ meanwhile.
+  const std::shared_ptr<obs_service_t> &service = this->service();
+  if (!service) {
+    return;
+  }
+
+  // updated in place; service() may be in use by the encoder settings.
+  obs_data_t *settings = obs_data_create();
+  obs_data_set_string(settings, "service", service_provider.c_str());
+  obs_data_set_string(settings, "server", stream_server.c_str());
+  obs_data_set_string(settings, "key", stream_key.c_str());
+  obs_data_set_bool(settings, "show_all", false);
+  obs_service_update(service.get(), settings);
+  obs_data_release(settings);
 }
 
 
-void ObsOutput::OnStopSignal(void *data, calldata_t * /*params*/) {
-  auto on_stopped = reinterpret_cast<OnStopped *>(data);
-  (*on_stopped)();
+void ObsOutput::ReleaseService() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (!service_) {
+    return;
+  }
+  obs_service_release(service_);
+  service_ = nullptr;
 }
 }  // namespace ncstreamer
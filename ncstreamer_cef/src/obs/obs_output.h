@@ -7,37 +7,131 @@
 #define NCSTREAMER_CEF_SRC_OBS_OBS_OUTPUT_H_
 
 
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
 #include <functional>
 #include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
 
 #include "obs-studio/libobs/obs.h"
 
+#include "ncstreamer_cef/src/obs/obs_reconnect_policy.h"
+
 
 namespace ncstreamer {
 class ObsOutput {
  public:
+  enum class StopReason {
+    kUser = 0,
+    kNetwork,
+    kTimeout,
+    kRemote,  // the server closed the stream.
+  };
+
   using OnStarted = std::function<void()>;
-  using OnStopped = std::function<void()>;
+  using OnStopped = std::function<void(StopReason reason)>;
+  using OnReconnecting = std::function<void(
+      int attempt,
+      const std::chrono::milliseconds &delay,
+      const std::string &stream_server)>;
+  using OnRecovered = std::function<void(
+      int attempts,
+      const std::string &stream_server)>;
 
-  ObsOutput();
+  explicit ObsOutput(const std::string &name);
   virtual ~ObsOutput();
 
+  // fallback_servers are tried in order when the policy switches server.
+  void UpdateService(
+      const std::string &service_provider,
+      const std::string &stream_server,
+      const std::string &stream_key,
+      const std::vector<std::string> &fallback_servers);
+  // takes effect on the next start.
+  void SetDelay(uint32_t delay_sec);
+  void SetReconnectPolicy(std::unique_ptr<ObsReconnectPolicy> policy);
+  void SetReconnectHandlers(
+      const OnReconnecting &on_reconnecting,
+      const OnRecovered &on_recovered);
+
+  // fails at once while a previous stop is still draining.
   bool Start(obs_encoder_t *audio_encoder,
              obs_encoder_t *video_encoder,
-             obs_service_t *service,
              const OnStarted &on_started,
-             const OnStopped &on_timeout);
-  void Stop(const OnStopped &on_stopped);
+             const OnStopped &on_stopped);
+  // lets the encoders drain until the deadline, then forces the stop.
+  // on_stopped is always called, at the latest shortly after the deadline.
+  // never blocks, so it may be called from on_stopped.
+  void Stop(const OnStopped &on_stopped,
+            const std::chrono::milliseconds &drain_timeout);
+  // blocks while a previous stop is still draining. must not be called
+  // from on_stopped.
+  void WaitForStop();
+
+  bool IsActive() const;
+  bool IsStopping() const;
+  bool IsReconnecting() const;
+  uint32_t GetActiveDelay() const;
+  float GetCongestion() const;
+  int GetDroppedFrames() const;
+  int GetTotalFrames() const;
+  uint64_t GetTotalBytes() const;
+
+  // holds its own reference; empty before UpdateService().
+  std::shared_ptr<obs_service_t> service() const;
 
  private:
+  enum class State {
+    kIdle = 0,
+    kActive,
+    kStopping,
+    kForceStopping,
+    kFinishing,  // on_stopped is being called.
+    kReconnecting,  // waiting for the next attempt.
+    kStarting,  // an attempt is calling obs_output_start.
+  };
+
   static void OnStartSignal(void *data, calldata_t *params);
   static void OnStopSignal(void *data, calldata_t *params);
 
+  static bool IsRetryable(long long code);  // NOLINT
+
+  void WatchStop(const std::chrono::milliseconds &drain_timeout);
+  void FinishStop(StopReason reason);
+  void Reconnect();
+  void UpdateServiceServer(const std::string &stream_server);
+  void ReleaseService();
+
+  const std::string name_;
   obs_output_t *output_;
+  // guarded by mutex_; the reconnector may use it while it is replaced.
+  obs_service_t *service_;
   signal_handler_t *const signal_handler_;
 
-  std::unique_ptr<OnStarted> on_started_;
-  std::unique_ptr<OnStopped> on_stopped_;
+  std::thread stop_watcher_;
+  std::thread reconnector_;
+  std::condition_variable state_cv_;
+  // This mutex is used for two purposes:
+  // 1) to synchronize accesses to the members below
+  // 2) for the condition variable state_cv_
+  mutable std::mutex mutex_;
+  State state_;
+  bool quits_;
+  OnStarted on_started_;
+  OnStopped on_stopped_;
+  OnReconnecting on_reconnecting_;
+  OnRecovered on_recovered_;
+
+  std::string service_provider_;
+  std::string stream_key_;
+  std::vector<std::string> stream_servers_;  // the primary comes first.
+  std::size_t server_index_;
+  std::unique_ptr<ObsReconnectPolicy> reconnect_policy_;
+  bool has_been_live_;  // reconnects only after the first start.
+  int reconnect_attempts_;
 };
 }  // namespace ncstreamer
 
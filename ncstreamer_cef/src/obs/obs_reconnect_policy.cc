@@ -0,0 +1,16 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/obs/obs_reconnect_policy.h"
+
+
+namespace ncstreamer {
+ObsReconnectPolicy::ObsReconnectPolicy() {
+}
+
+
+ObsReconnectPolicy::~ObsReconnectPolicy() {
+}
+}  // namespace ncstreamer
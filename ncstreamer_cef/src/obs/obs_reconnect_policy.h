@@ -0,0 +1,30 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_OBS_OBS_RECONNECT_POLICY_H_
+#define NCSTREAMER_CEF_SRC_OBS_OBS_RECONNECT_POLICY_H_
+
+
+#include <chrono>  // NOLINT
+
+
+namespace ncstreamer {
+class ObsReconnectPolicy {
+ public:
+  ObsReconnectPolicy();
+  virtual ~ObsReconnectPolicy() = 0;
+
+  // called whenever the output is live again.
+  virtual void Reset() = 0;
+
+  // returns false when the output should give up.
+  virtual bool NextAttempt(
+      std::chrono::milliseconds *delay,
+      bool *switches_server) = 0;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_OBS_OBS_RECONNECT_POLICY_H_
@@ -0,0 +1,310 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/obs/obs_record_output.h"
+
+#include <algorithm>
+
+#include "obs-studio/libobs/util/platform.h"
+
+
+namespace ncstreamer {
+ObsRecordOutput::ObsRecordOutput()
+    : audio_encoder_{nullptr},
+      video_encoder_{nullptr},
+      directory_{},
+      format_{},
+      max_bytes_{0},
+      max_time_{0},
+      segment_index_{0},
+      output_{nullptr},
+      next_output_{nullptr},
+      draining_outputs_{},
+      replay_buffer_{nullptr},
+      segmenter_{},
+      stop_cv_{},
+      mutex_{},
+      stops_{false},
+      stopped_mutex_{},
+      stopped_outputs_{} {
+}
+
+
+ObsRecordOutput::~ObsRecordOutput() {
+  Stop();
+}
+
+
+bool ObsRecordOutput::StartRecording(
+    obs_encoder_t *audio_encoder,
+    obs_encoder_t *video_encoder,
+    const std::string &directory,
+    const std::string &format,
+    uint32_t max_size_mb,
+    uint32_t max_time_sec) {
+  if (IsReplayBufferActive() == true) {
+    return false;
+  }
+  Stop();
+
+  std::lock_guard<std::mutex> lock{mutex_};
+  audio_encoder_ = audio_encoder;
+  video_encoder_ = video_encoder;
+  directory_ = directory;
+  format_ = format;
+  max_bytes_ = static_cast<uint64_t>(max_size_mb) * 1024 * 1024;
+  max_time_ = std::chrono::seconds{max_time_sec};
+  segment_index_ = 0;
+  stops_ = false;
+
+  output_ = StartSegment();
+  if (!output_) {
+    return false;
+  }
+
+  if (max_bytes_ > 0 || max_time_.count() > 0) {
+    segmenter_ = std::thread{&ObsRecordOutput::RunSegmenter, this};
+  }
+  return true;
+}
+
+
+bool ObsRecordOutput::StartReplayBuffer(
+    obs_encoder_t *audio_encoder,
+    obs_encoder_t *video_encoder,
+    const std::string &directory,
+    const std::string &format,
+    uint32_t max_size_mb,
+    uint32_t max_time_sec) {
+  if (IsRecordingActive() == true) {
+    return false;
+  }
+  Stop();
+
+  obs_data_t *settings = obs_data_create();
+  obs_data_set_string(settings, "directory", directory.c_str());
+  obs_data_set_string(settings, "format", "Replay %CCYY-%MM-%DD %hh-%mm-%ss");
+  obs_data_set_string(settings, "extension", format.c_str());
+  obs_data_set_int(settings, "max_size_mb", max_size_mb);
+  obs_data_set_int(settings, "max_time_sec", max_time_sec);
+  obs_output_t *replay_buffer = obs_output_create(
+      "replay_buffer", "replay_buffer", settings, nullptr);
+  obs_data_release(settings);
+
+  obs_output_set_audio_encoder(replay_buffer, audio_encoder, 0);
+  obs_output_set_video_encoder(replay_buffer, video_encoder);
+  if (obs_output_start(replay_buffer) == false) {
+    obs_output_release(replay_buffer);
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock{mutex_};
+  replay_buffer_ = replay_buffer;
+  return true;
+}
+
+
+bool ObsRecordOutput::SaveReplayBuffer() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (!replay_buffer_ || obs_output_active(replay_buffer_) == false) {
+    return false;
+  }
+
+  calldata_t params{};
+  proc_handler_t *handler = obs_output_get_proc_handler(replay_buffer_);
+  bool called = proc_handler_call(handler, "save", &params);
+  calldata_free(&params);
+  return called;
+}
+
+
+void ObsRecordOutput::Stop() {
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    stops_ = true;
+  }
+  stop_cv_.notify_all();
+  if (segmenter_.joinable() == true) {
+    segmenter_.join();
+  }
+
+  std::lock_guard<std::mutex> lock{mutex_};
+  ReleaseOutputs();
+}
+
+
+bool ObsRecordOutput::IsActive() const {
+  return IsRecordingActive() == true || IsReplayBufferActive() == true;
+}
+
+
+bool ObsRecordOutput::IsRecordingActive() const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  return output_ && obs_output_active(output_);
+}
+
+
+bool ObsRecordOutput::IsReplayBufferActive() const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  return replay_buffer_ && obs_output_active(replay_buffer_);
+}
+
+
+void ObsRecordOutput::OnSegmentStopped(void *data, calldata_t *params) {
+  auto self = reinterpret_cast<ObsRecordOutput *>(data);
+  auto output = reinterpret_cast<obs_output_t *>(
+      calldata_ptr(params, "output"));
+
+  std::lock_guard<std::mutex> lock{self->stopped_mutex_};
+  self->stopped_outputs_.emplace_back(output);
+}
+
+
+std::string ObsRecordOutput::MakeFilePath(
+    const std::string &directory,
+    const std::string &format,
+    uint32_t segment_index) {
+  const std::string &pattern =
+      "%CCYY-%MM-%DD %hh-%mm-%ss #" + std::to_string(segment_index);
+  char *file_name = os_generate_formatted_filename(
+      format.c_str(), true, pattern.c_str());
+  const std::string &path = directory + "\\" + file_name;
+  bfree(file_name);
+  return path;
+}
+
+
+obs_output_t *ObsRecordOutput::StartSegment() {
+  static int segment_count{0};
+  const std::string &name =
+      "record_segment_" + std::to_string(++segment_count);
+
+  obs_data_t *settings = obs_data_create();
+  obs_data_set_string(settings, "path",
+      MakeFilePath(directory_, format_, ++segment_index_).c_str());
+  obs_output_t *output = obs_output_create(
+      "ffmpeg_muxer", name.c_str(), settings, nullptr);
+  obs_data_release(settings);
+
+  obs_output_set_audio_encoder(output, audio_encoder_, 0);
+  obs_output_set_video_encoder(output, video_encoder_);
+  if (obs_output_start(output) == false) {
+    obs_output_release(output);
+    return nullptr;
+  }
+  return output;
+}
+
+
+void ObsRecordOutput::RunSegmenter() {
+  static const std::chrono::milliseconds kCheckInterval{1000};
+  // short enough that two files overlap by little more than a keyframe.
+  static const std::chrono::milliseconds kHandOverInterval{100};
+
+  auto started_at = std::chrono::steady_clock::now();
+  std::unique_lock<std::mutex> lock{mutex_};
+  while (stop_cv_.wait_for(lock,
+      next_output_ ? kHandOverInterval : kCheckInterval, [this]() {
+    return stops_;
+  }) == false) {
+    ReleaseStoppedSegments();
+
+    if (next_output_) {
+      if (HandOver() == true) {
+        started_at = std::chrono::steady_clock::now();
+      }
+      continue;
+    }
+    if (!output_ || ReachesLimit(started_at) == false) {
+      continue;
+    }
+    // the current muxer keeps writing until the next one has started.
+    next_output_ = StartSegment();
+  }
+}
+
+
+bool ObsRecordOutput::HandOver() {
+  // the muxer writes nothing before its first keyframe.
+  if (obs_output_active(next_output_) == false ||
+      obs_output_get_total_bytes(next_output_) == 0) {
+    return false;
+  }
+
+  obs_output_t *previous = output_;
+  output_ = next_output_;
+  next_output_ = nullptr;
+
+  draining_outputs_.emplace_back(previous);
+  signal_handler_connect(obs_output_get_signal_handler(previous), "stop",
+                         OnSegmentStopped, this);
+  obs_output_stop(previous);
+  return true;
+}
+
+
+void ObsRecordOutput::ReleaseStoppedSegments() {
+  std::vector<obs_output_t *> stopped;
+  {
+    std::lock_guard<std::mutex> lock{stopped_mutex_};
+    stopped.swap(stopped_outputs_);
+  }
+  for (obs_output_t *output : stopped) {
+    auto i = std::find(
+        draining_outputs_.begin(), draining_outputs_.end(), output);
+    if (i == draining_outputs_.end()) {
+      continue;
+    }
+    draining_outputs_.erase(i);
+    signal_handler_disconnect(obs_output_get_signal_handler(output), "stop",
+                              OnSegmentStopped, this);
+    obs_output_release(output);
+  }
+}
+
+
+bool ObsRecordOutput::ReachesLimit(
+    std::chrono::steady_clock::time_point started_at) const {
+  if (max_bytes_ > 0 && obs_output_get_total_bytes(output_) >= max_bytes_) {
+    return true;
+  }
+  if (max_time_.count() > 0 &&
+      std::chrono::steady_clock::now() - started_at >= max_time_) {
+    return true;
+  }
+  return false;
+}
+
+
+void ObsRecordOutput::ReleaseOutputs() {
+  // whatever is still draining is released here; releasing stops it.
+  for (obs_output_t *output : draining_outputs_) {
+    signal_handler_disconnect(obs_output_get_signal_handler(output), "stop",
+                              OnSegmentStopped, this);
+    obs_output_release(output);
+  }
+  draining_outputs_.clear();
+  {
+    std::lock_guard<std::mutex> lock{stopped_mutex_};
+    stopped_outputs_.clear();
+  }
+
+  if (next_output_) {
+    obs_output_stop(next_output_);
+    obs_output_release(next_output_);
+    next_output_ = nullptr;
+  }
+  if (output_) {
+    obs_output_stop(output_);
+    obs_output_release(output_);
+    output_ = nullptr;
+  }
+  if (replay_buffer_) {
+    obs_output_stop(replay_buffer_);
+    obs_output_release(replay_buffer_);
+    replay_buffer_ = nullptr;
+  }
+}
+}  // namespace ncstreamer
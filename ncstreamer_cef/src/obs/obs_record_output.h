@@ -0,0 +1,97 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_OBS_OBS_RECORD_OUTPUT_H_
+#define NCSTREAMER_CEF_SRC_OBS_OBS_RECORD_OUTPUT_H_
+
+
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "obs-studio/libobs/obs.h"
+
+
+namespace ncstreamer {
+class ObsRecordOutput {
+ public:
+  ObsRecordOutput();
+  virtual ~ObsRecordOutput();
+
+  // a zero limit means the file is never split by that limit.
+  // recording and the replay buffer exclude each other; starting one while
+  // the other runs fails, and Stop() ends whichever is running.
+  bool StartRecording(
+      obs_encoder_t *audio_encoder,
+      obs_encoder_t *video_encoder,
+      const std::string &directory,
+      const std::string &format,
+      uint32_t max_size_mb,
+      uint32_t max_time_sec);
+  bool StartReplayBuffer(
+      obs_encoder_t *audio_encoder,
+      obs_encoder_t *video_encoder,
+      const std::string &directory,
+      const std::string &format,
+      uint32_t max_size_mb,
+      uint32_t max_time_sec);
+  bool SaveReplayBuffer();
+  void Stop();
+
+  bool IsActive() const;
+  bool IsRecordingActive() const;
+  bool IsReplayBufferActive() const;
+
+ private:
+  static void OnSegmentStopped(void *data, calldata_t *params);
+  static std::string MakeFilePath(
+      const std::string &directory,
+      const std::string &format,
+      uint32_t segment_index);
+
+  obs_output_t *StartSegment();
+  void RunSegmenter();
+  bool HandOver();
+  void ReleaseStoppedSegments();
+  bool ReachesLimit(std::chrono::steady_clock::time_point started_at) const;
+  void ReleaseOutputs();
+
+  obs_encoder_t *audio_encoder_;
+  obs_encoder_t *video_encoder_;
+  std::string directory_;
+  std::string format_;
+  uint64_t max_bytes_;
+  std::chrono::seconds max_time_;
+  // segments started within the same second still get distinct files.
+  uint32_t segment_index_;
+
+  // the muxer currently writing. a segment is handed over to next_output_
+  // only once it has written its first keyframe, so no packet falls
+  // between two files; the old muxer is released from its stop signal.
+  obs_output_t *output_;
+  obs_output_t *next_output_;
+  std::vector<obs_output_t *> draining_outputs_;
+  obs_output_t *replay_buffer_;
+
+  std::thread segmenter_;
+  std::condition_variable stop_cv_;
+  // This mutex is used for two purposes:
+  // 1) to synchronize accesses to stops_ and the outputs
+  // 2) for the condition variable stop_cv_
+  mutable std::mutex mutex_;
+  bool stops_;
+
+  // the stop signal may fire inside obs_output_stop, under mutex_.
+  std::mutex stopped_mutex_;
+  std::vector<obs_output_t *> stopped_outputs_;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_OBS_OBS_RECORD_OUTPUT_H_
@@ -0,0 +1,122 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/obs/obs_resolution_watcher.h"
+
+#include <codecvt>
+#include <locale>
+
+#include "obs-studio/plugins/win-capture/graphics-hook-info.h"
+
+#include "ncstreamer_cef/src/obs/obs_source_info.h"
+
+
+namespace ncstreamer {
+ObsResolutionWatcher::ObsResolutionWatcher()
+    : stop_event_{::CreateEvent(nullptr, true, false, nullptr)},
+      thread_{} {
+}
+
+
+ObsResolutionWatcher::~ObsResolutionWatcher() {
+  Unwatch();
+  ::CloseHandle(stop_event_);
+}
+
+
+Dimension<uint32_t> ObsResolutionWatcher::GetWindowSize(
+    const std::string &source_info) {
+  HWND handle = FindSourceWindow(source_info);
+  RECT rect;
+  if (!handle || !::GetClientRect(handle, &rect)) {
+    return {0, 0};
+  }
+  return {static_cast<uint32_t>(rect.right - rect.left),
+          static_cast<uint32_t>(rect.bottom - rect.top)};
+}
+
+
+void ObsResolutionWatcher::Watch(
+    const std::string &source_info,
+    const OnResized &on_resized) {
+  Unwatch();
+
+  HWND handle = FindSourceWindow(source_info);
+  if (!handle) {
+    return;
+  }
+  DWORD process_id{0};
+  ::GetWindowThreadProcessId(handle, &process_id);
+
+  ::ResetEvent(stop_event_);
+  thread_ = std::thread{
+      &ObsResolutionWatcher::WatchHookInfo, this, process_id, on_resized};
+}
+
+
+void ObsResolutionWatcher::Unwatch() {
+  if (thread_.joinable() == false) {
+    return;
+  }
+  ::SetEvent(stop_event_);
+  thread_.join();
+}
+
+
+HWND ObsResolutionWatcher::FindSourceWindow(const std::string &source_info) {
+  ObsSourceInfo source{source_info};
+
+  std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
+  const std::wstring &w_class = converter.from_bytes(source.clazz());
+  const std::wstring &w_title = converter.from_bytes(source.title());
+
+  return ::FindWindowExW(nullptr, nullptr, w_class.c_str(), w_title.c_str());
+}
+
+
+void ObsResolutionWatcher::WatchHookInfo(
+    DWORD process_id,
+    const OnResized &on_resized) {
+  static const DWORD kOpenRetryInterval{100};
+  static const DWORD kResizeCheckInterval{500};
+
+  const std::wstring &map_name =
+      L"CaptureHook_HookInfo" + std::to_wstring(process_id);
+
+  HANDLE hook_info_map{nullptr};
+  while (true) {
+    hook_info_map = ::OpenFileMapping(FILE_MAP_READ, false, map_name.c_str());
+    if (hook_info_map) {
+      break;
+    }
+    if (::WaitForSingleObject(stop_event_, kOpenRetryInterval) !=
+        WAIT_TIMEOUT) {
+      return;
+    }
+  }
+
+  auto info = reinterpret_cast<const struct hook_info *>(::MapViewOfFile(
+      hook_info_map, FILE_MAP_READ, 0, 0, sizeof(struct hook_info)));
+  if (!info) {
+    ::CloseHandle(hook_info_map);
+    return;
+  }
+
+  uint32_t cx{0};
+  uint32_t cy{0};
+  do {
+    if (info->cx != 0 && info->cy != 0 &&
+        (info->cx != cx || info->cy != cy)) {
+      cx = info->cx;
+      cy = info->cy;
+      on_resized({cx, cy});
+    }
+  } while (::WaitForSingleObject(stop_event_, kResizeCheckInterval) ==
+           WAIT_TIMEOUT);
+
+  ::UnmapViewOfFile(info);
+  ::CloseHandle(hook_info_map);
+}
+}  // namespace ncstreamer
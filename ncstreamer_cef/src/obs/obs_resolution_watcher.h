@@ -0,0 +1,43 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_OBS_OBS_RESOLUTION_WATCHER_H_
+#define NCSTREAMER_CEF_SRC_OBS_OBS_RESOLUTION_WATCHER_H_
+
+
+#include <functional>
+#include <string>
+#include <thread>  // NOLINT
+
+#include "windows.h"  // NOLINT
+
+#include "ncstreamer_cef/src/lib/dimension.h"
+
+
+namespace ncstreamer {
+class ObsResolutionWatcher {
+ public:
+  using OnResized = std::function<void(const Dimension<uint32_t> &size)>;
+
+  ObsResolutionWatcher();
+  virtual ~ObsResolutionWatcher();
+
+  static Dimension<uint32_t> GetWindowSize(const std::string &source_info);
+
+  void Watch(const std::string &source_info, const OnResized &on_resized);
+  void Unwatch();
+
+ private:
+  static HWND FindSourceWindow(const std::string &source_info);
+
+  void WatchHookInfo(DWORD process_id, const OnResized &on_resized);
+
+  HANDLE stop_event_;
+  std::thread thread_;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_OBS_OBS_RESOLUTION_WATCHER_H_
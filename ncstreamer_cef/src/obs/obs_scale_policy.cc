@@ -0,0 +1,101 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/obs/obs_scale_policy.h"
+
+
+namespace ncstreamer {
+ObsScalePolicy::Choice::Choice(
+    obs_scale_type scale_type, video_colorspace colorspace)
+    : scale_type{scale_type},
+      colorspace{colorspace} {
+}
+
+
+ObsScalePolicy::ObsScalePolicy(uint64_t budget)
+    : budget_{budget} {
+}
+
+
+ObsScalePolicy::~ObsScalePolicy() {
+}
+
+
+const char *ObsScalePolicy::ToString(obs_scale_type scale_type) {
+  switch (scale_type) {
+  case OBS_SCALE_POINT:
+    return "point";
+  case OBS_SCALE_BILINEAR:
+    return "bilinear";
+  case OBS_SCALE_BICUBIC:
+    return "bicubic";
+  case OBS_SCALE_LANCZOS:
+    return "lanczos";
+  default:
+    break;
+  }
+  return "disable";
+}
+
+
+const char *ObsScalePolicy::ToString(video_colorspace colorspace) {
+  switch (colorspace) {
+  case VIDEO_CS_709:
+    return "709";
+  default:
+    break;
+  }
+  return "601";
+}
+
+
+ObsScalePolicy::Choice ObsScalePolicy::Choose(
+    const Dimension<uint32_t> &base_size,
+    const Dimension<uint32_t> &output_size,
+    uint32_t fps) const {
+  // HD outputs are decoded as BT.709 by players and services.
+  const video_colorspace colorspace =
+      (output_size.height() >= 720) ? VIDEO_CS_709 : VIDEO_CS_601;
+
+  const bool downscales =
+      base_size.width() > output_size.width() ||
+      base_size.height() > output_size.height();
+  const bool upscales =
+      base_size.width() < output_size.width() ||
+      base_size.height() < output_size.height();
+  if (downscales == false && upscales == false) {
+    return Choice{OBS_SCALE_BILINEAR, colorspace};
+  }
+
+  const uint64_t pixel_rate =
+      static_cast<uint64_t>(output_size.width()) * output_size.height() * fps;
+  // lanczos only pays off when it has source pixels to sample.
+  const obs_scale_type kCandidates[] = {
+      downscales ? OBS_SCALE_LANCZOS : OBS_SCALE_BICUBIC,
+      OBS_SCALE_BICUBIC,
+      OBS_SCALE_BILINEAR};
+  for (obs_scale_type candidate : kCandidates) {
+    if (pixel_rate * GetTaps(candidate) <= budget_) {
+      return Choice{candidate, colorspace};
+    }
+  }
+  return Choice{OBS_SCALE_BILINEAR, colorspace};
+}
+
+
+uint32_t ObsScalePolicy::GetTaps(obs_scale_type scale_type) {
+  switch (scale_type) {
+  case OBS_SCALE_BILINEAR:
+    return 4;
+  case OBS_SCALE_BICUBIC:
+    return 16;
+  case OBS_SCALE_LANCZOS:
+    return 36;
+  default:
+    break;
+  }
+  return 1;
+}
+}  // namespace ncstreamer
@@ -0,0 +1,54 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_OBS_OBS_SCALE_POLICY_H_
+#define NCSTREAMER_CEF_SRC_OBS_OBS_SCALE_POLICY_H_
+
+
+#include <cstdint>
+
+#include "obs-studio/libobs/obs.h"
+
+#include "ncstreamer_cef/src/lib/dimension.h"
+
+
+namespace ncstreamer {
+// Picks the GPU scaler and colorspace for a base->output resize. Scalers
+// cost roughly their filter taps per output pixel, so the best one whose
+// tap rate fits the budget wins.
+class ObsScalePolicy {
+ public:
+  class Choice {
+   public:
+    Choice(obs_scale_type scale_type, video_colorspace colorspace);
+
+    obs_scale_type scale_type;
+    video_colorspace colorspace;
+  };
+
+  // taps per second; the default affords lanczos at 720p30 and bicubic at
+  // 720p60 or 1080p30.
+  static const uint64_t kDefaultBudget{1500000000};
+
+  explicit ObsScalePolicy(uint64_t budget);
+  virtual ~ObsScalePolicy();
+
+  static const char *ToString(obs_scale_type scale_type);
+  static const char *ToString(video_colorspace colorspace);
+
+  Choice Choose(
+      const Dimension<uint32_t> &base_size,
+      const Dimension<uint32_t> &output_size,
+      uint32_t fps) const;
+
+ private:
+  static uint32_t GetTaps(obs_scale_type scale_type);
+
+  const uint64_t budget_;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_OBS_OBS_SCALE_POLICY_H_
@@ -0,0 +1,156 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/obs/obs_scene_cache.h"
+
+#include <functional>
+#include <utility>
+
+#include "ncstreamer_cef/src/obs/obs_source_info.h"
+
+
+namespace ncstreamer {
+ObsSceneCache::ObsSceneCache(
+    obs_scene_t *scene, const std::string &source_id)
+    : scene_{scene},
+      source_id_{source_id},
+      mutex_{},
+      entries_{},
+      active_item_{nullptr},
+      use_count_{0} {
+}
+
+
+ObsSceneCache::~ObsSceneCache() {
+  Clear();
+}
+
+
+obs_sceneitem_t *ObsSceneCache::Activate(const std::string &source_info) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  HideActiveItem();
+
+  ObsSourceInfo source{source_info};
+  const Key key{source.clazz(), source.title(), source.exe_name()};
+
+  auto i = entries_.find(key);
+  if (i == entries_.end()) {
+    static const std::size_t kMaxCachedSources{4};
+    if (entries_.size() >= kMaxCachedSources) {
+      EvictLeastRecentlyUsed();
+    }
+    i = entries_.emplace(key, Entry{CreateItem(source_info), 0}).first;
+  }
+
+  i->second.last_used = ++use_count_;
+  active_item_ = i->second.item;
+  obs_sceneitem_set_visible(active_item_, true);
+  return active_item_;
+}
+
+
+void ObsSceneCache::Deactivate() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  HideActiveItem();
+}
+
+
+void ObsSceneCache::Clear() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  active_item_ = nullptr;
+  for (auto &entry : entries_) {
+    obs_sceneitem_remove(entry.second.item);
+    obs_sceneitem_release(entry.second.item);
+  }
+  entries_.clear();
+}
+
+
+obs_sceneitem_t *ObsSceneCache::active_item() const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  return active_item_;
+}
+
+
+std::shared_ptr<obs_sceneitem_t> ObsSceneCache::ShareActiveItem() const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (active_item_ == nullptr) {
+    return nullptr;
+  }
+  obs_sceneitem_addref(active_item_);
+  return std::shared_ptr<obs_sceneitem_t>{active_item_, obs_sceneitem_release};
+}
+
+
+std::size_t ObsSceneCache::KeyHasher::operator()(const Key &key) const {
+  std::hash<std::string> hasher;
+  std::size_t seed = hasher(std::get<0>(key));
+  seed ^= hasher(std::get<1>(key)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  seed ^= hasher(std::get<2>(key)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  return seed;
+}
+
+
+ObsSceneCache::Entry::Entry(obs_sceneitem_t *item, uint64_t last_used)
+    : item{item},
+      last_used{last_used} {
+}
+
+
+void ObsSceneCache::AddSourceToScene(void *data, obs_scene_t *scene) {
+  auto param = reinterpret_cast<std::pair<obs_source_t *,
+                                          obs_sceneitem_t *> *>(data);
+  param->second = obs_scene_add(scene, param->first);
+  obs_sceneitem_addref(param->second);
+}
+
+
+obs_sceneitem_t *ObsSceneCache::CreateItem(const std::string &source_info) {
+  ObsSourceInfo source{source_info};
+  const std::string &name = "Game Capture: " + source.exe_name();
+
+  obs_data_t *settings = obs_data_create();
+  obs_data_set_string(settings, "window", source_info.c_str());
+  obs_data_set_string(settings, "capture_mode", "window");
+  obs_source_t *game_source = obs_source_create(
+      source_id_.c_str(), name.c_str(), settings, nullptr);
+  obs_data_release(settings);
+
+  std::pair<obs_source_t *, obs_sceneitem_t *> param{game_source, nullptr};
+  obs_scene_atomic_update(scene_, ObsSceneCache::AddSourceToScene, &param);
+  obs_source_release(game_source);
+  return param.second;
+}
+
+
+void ObsSceneCache::HideActiveItem() {
+  if (active_item_ == nullptr) {
+    return;
+  }
+  obs_sceneitem_set_visible(active_item_, false);
+  active_item_ = nullptr;
+}
+
+
+void ObsSceneCache::EvictLeastRecentlyUsed() {
+  auto victim = entries_.end();
+  for (auto i = entries_.begin(); i != entries_.end(); ++i) {
+    if (i->second.item == active_item_) {
+      continue;
+    }
+    if (victim == entries_.end() ||
+        i->second.last_used < victim->second.last_used) {
+      victim = i;
+    }
+  }
+  if (victim == entries_.end()) {
+    return;
+  }
+
+  obs_sceneitem_remove(victim->second.item);
+  obs_sceneitem_release(victim->second.item);
+  entries_.erase(victim);
+}
+}  // namespace ncstreamer
@@ -0,0 +1,71 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_OBS_OBS_SCENE_CACHE_H_
+#define NCSTREAMER_CEF_SRC_OBS_OBS_SCENE_CACHE_H_
+
+
+#include <cstdint>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+#include "obs-studio/libobs/obs.h"
+
+
+namespace ncstreamer {
+class ObsSceneCache {
+ public:
+  ObsSceneCache(obs_scene_t *scene, const std::string &source_id);
+  virtual ~ObsSceneCache();
+
+  obs_sceneitem_t *Activate(const std::string &source_info);
+  void Deactivate();
+  void Clear();
+
+  obs_sceneitem_t *active_item() const;
+  // holds its own reference, so it outlives an eviction on another thread.
+  std::shared_ptr<obs_sceneitem_t> ShareActiveItem() const;
+
+ private:
+  using Key = std::tuple<std::string /*class*/,
+                         std::string /*title*/,
+                         std::string /*exe*/>;
+
+  class KeyHasher {
+   public:
+    std::size_t operator()(const Key &key) const;
+  };
+
+  class Entry {
+   public:
+    Entry(obs_sceneitem_t *item, uint64_t last_used);
+
+    obs_sceneitem_t *item;
+    uint64_t last_used;
+  };
+
+  static void AddSourceToScene(void *data, obs_scene_t *scene);
+
+  obs_sceneitem_t *CreateItem(const std::string &source_info);
+  void HideActiveItem();
+  void EvictLeastRecentlyUsed();
+
+  obs_scene_t *const scene_;
+  const std::string source_id_;
+
+  // the UI thread activates items while websocket handlers read the
+  // active one.
+  mutable std::mutex mutex_;
+  std::unordered_map<Key, Entry, KeyHasher> entries_;
+  obs_sceneitem_t *active_item_;
+  uint64_t use_count_;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_OBS_OBS_SCENE_CACHE_H_
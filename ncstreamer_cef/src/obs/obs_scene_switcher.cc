@@ -0,0 +1,119 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/obs/obs_scene_switcher.h"
+
+#include <algorithm>
+
+
+namespace ncstreamer {
+ObsSceneSwitcher::ObsSceneSwitcher(
+    const std::string &first_name, obs_scene_t *first_scene)
+    : mutex_{},
+      scenes_{},
+      transitions_{},
+      current_{first_name} {
+  obs_scene_addref(first_scene);
+  scenes_.emplace(first_name, first_scene);
+  obs_set_output_source(0, obs_scene_get_source(first_scene));
+}
+
+
+ObsSceneSwitcher::~ObsSceneSwitcher() {
+  obs_set_output_source(0, nullptr);
+  for (auto &transition : transitions_) {
+    obs_source_release(transition.second);
+  }
+  for (auto &scene : scenes_) {
+    obs_scene_release(scene.second);
+  }
+}
+
+
+obs_scene_t *ObsSceneSwitcher::AddScene(const std::string &name) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  auto i = scenes_.find(name);
+  if (i != scenes_.end()) {
+    return i->second;
+  }
+  obs_scene_t *scene = obs_scene_create(name.c_str());
+  scenes_.emplace(name, scene);
+  return scene;
+}
+
+
+obs_scene_t *ObsSceneSwitcher::scene(const std::string &name) const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  auto i = scenes_.find(name);
+  return (i == scenes_.end()) ? nullptr : i->second;
+}
+
+
+std::vector<std::string> ObsSceneSwitcher::GetSceneNames() const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  std::vector<std::string> names;
+  for (const auto &scene : scenes_) {
+    names.emplace_back(scene.first);
+  }
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
+
+std::string ObsSceneSwitcher::current() const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  return current_;
+}
+
+
+bool ObsSceneSwitcher::SwitchTo(
+    const std::string &name,
+    const std::string &transition_id,
+    uint32_t duration_ms) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  auto next_i = scenes_.find(name);
+  if (next_i == scenes_.end()) {
+    return false;
+  }
+  obs_source_t *next = obs_scene_get_source(next_i->second);
+
+  if (transition_id.empty() == true) {
+    obs_set_output_source(0, next);
+    current_ = name;
+    return true;
+  }
+
+  obs_source_t *transition = FindTransition(transition_id);
+  if (!transition) {
+    return false;
+  }
+  obs_source_t *prev = obs_scene_get_source(scenes_.at(current_));
+  obs_transition_set(transition, prev);
+  obs_set_output_source(0, transition);
+  if (obs_transition_start(transition, OBS_TRANSITION_MODE_AUTO,
+                           duration_ms, next) == false) {
+    obs_set_output_source(0, next);
+  }
+  current_ = name;
+  return true;
+}
+
+
+obs_source_t *ObsSceneSwitcher::FindTransition(
+    const std::string &transition_id) {
+  auto i = transitions_.find(transition_id);
+  if (i != transitions_.end()) {
+    return i->second;
+  }
+
+  obs_source_t *transition = obs_source_create_private(
+      transition_id.c_str(), transition_id.c_str(), nullptr);
+  if (!transition) {
+    return nullptr;
+  }
+  transitions_.emplace(transition_id, transition);
+  return transition;
+}
+}  // namespace ncstreamer
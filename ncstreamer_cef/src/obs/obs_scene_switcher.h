@@ -0,0 +1,50 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_OBS_OBS_SCENE_SWITCHER_H_
+#define NCSTREAMER_CEF_SRC_OBS_OBS_SCENE_SWITCHER_H_
+
+
+#include <cstdint>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "obs-studio/libobs/obs.h"
+
+
+namespace ncstreamer {
+// Keeps every named scene loaded so that switching only changes what
+// output channel 0 points at. Scenes that are not shown are not rendered.
+class ObsSceneSwitcher {
+ public:
+  ObsSceneSwitcher(const std::string &first_name, obs_scene_t *first_scene);
+  virtual ~ObsSceneSwitcher();
+
+  obs_scene_t *AddScene(const std::string &name);
+  obs_scene_t *scene(const std::string &name) const;
+  std::vector<std::string> GetSceneNames() const;
+  std::string current() const;
+
+  // an empty transition_id cuts at once; otherwise transition_id names a
+  // libobs transition such as "fade_transition".
+  bool SwitchTo(
+      const std::string &name,
+      const std::string &transition_id,
+      uint32_t duration_ms);
+
+ private:
+  obs_source_t *FindTransition(const std::string &transition_id);
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, obs_scene_t *> scenes_;
+  std::unordered_map<std::string, obs_source_t *> transitions_;
+  std::string current_;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_OBS_OBS_SCENE_SWITCHER_H_
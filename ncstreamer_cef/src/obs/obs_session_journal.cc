@@ -0,0 +1,223 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/obs/obs_session_journal.h"
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdio>
+#include <ctime>
+#include <utility>
+#include <vector>
+
+#include "boost/filesystem.hpp"
+#include "boost/property_tree/json_parser.hpp"
+
+
+namespace ncstreamer {
+ObsSessionJournal::ObsSessionJournal(const std::string &directory)
+    : directory_{directory},
+      mutex_{},
+      file_{},
+      session_id_{},
+      part_{0},
+      cpu_info_{nullptr} {
+}
+
+
+ObsSessionJournal::~ObsSessionJournal() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (cpu_info_) {
+    os_cpu_usage_info_destroy(cpu_info_);
+  }
+}
+
+
+void ObsSessionJournal::Open(const boost::property_tree::ptree &session) {
+  if (directory_.empty() == true) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (file_.is_open() == true) {
+      file_.close();
+    }
+
+    // milliseconds keep two sessions in the same second apart.
+    const auto now = std::chrono::system_clock::now();
+    const std::time_t now_sec = std::chrono::system_clock::to_time_t(now);
+    const auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        now.time_since_epoch()).count() % 1000;
+    char id[32];
+    std::strftime(id, sizeof(id), "session-%Y%m%d-%H%M%S",
+                  std::localtime(&now_sec));
+    char id_ms[40];
+    std::snprintf(id_ms, sizeof(id_ms), "%s-%03d",
+                  id, static_cast<int>(now_ms));
+    session_id_ = id_ms;
+    part_ = 0;
+
+    if (cpu_info_) {
+      os_cpu_usage_info_destroy(cpu_info_);
+    }
+    cpu_info_ = os_cpu_usage_info_start();
+
+    OpenPart();
+  }
+
+  boost::property_tree::ptree record{session};
+  Write("start", &record);
+}
+
+
+void ObsSessionJournal::WriteSample(const ObsStatsSampler::Sample &sample) {
+  boost::property_tree::ptree record;
+  record.put("bitrate", sample.bitrate);
+  record.put("dropped", sample.dropped_frames);
+  record.put("output", sample.output_frames);
+  record.put("lagged", sample.lagged_frames);
+  record.put("skipped", sample.skipped_frames);
+  record.put("frameTimeMs", sample.average_frame_time_ms);
+  record.put("congestion", sample.congestion);
+  Write("sample", &record);
+}
+
+
+void ObsSessionJournal::WriteReconnect(
+    int attempt, const std::string &server) {
+  boost::property_tree::ptree record;
+  record.put("attempt", attempt);
+  record.put("server", server);
+  Write("reconnect", &record);
+}
+
+
+void ObsSessionJournal::WriteRecovered(
+    int attempts, const std::string &server) {
+  boost::property_tree::ptree record;
+  record.put("attempts", attempts);
+  record.put("server", server);
+  Write("recovered", &record);
+}
+
+
+void ObsSessionJournal::Close(ObsOutput::StopReason reason) {
+  boost::property_tree::ptree record;
+  record.put("reason", ToString(reason));
+  Write("stop", &record);
+  CloseFile();
+}
+
+
+void ObsSessionJournal::Abort() {
+  boost::property_tree::ptree record;
+  record.put("reason", "notStarted");
+  Write("stop", &record);
+  CloseFile();
+}
+
+
+const char *ObsSessionJournal::ToString(ObsOutput::StopReason reason) {
+  switch (reason) {
+  case ObsOutput::StopReason::kUser:
+    return "user";
+  case ObsOutput::StopReason::kNetwork:
+    return "network";
+  case ObsOutput::StopReason::kTimeout:
+    return "timeout";
+  case ObsOutput::StopReason::kRemote:
+    return "remote";
+  default:
+    break;
+  }
+  return "unknown";
+}
+
+
+void ObsSessionJournal::Write(
+    const std::string &event, boost::property_tree::ptree *record) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (file_.is_open() == false) {
+    return;
+  }
+
+  record->put("time", std::chrono::duration_cast<std::chrono::seconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count());
+  record->put("event", event);
+  if (cpu_info_) {
+    record->put("cpu", os_cpu_usage_info_query(cpu_info_));
+  }
+
+  boost::property_tree::write_json(file_, *record, false);
+  file_.flush();
+
+  if (static_cast<uint64_t>(file_.tellp()) >= kMaxFileSize) {
+    file_.close();
+    ++part_;
+    OpenPart();
+  }
+}
+
+
+void ObsSessionJournal::OpenPart() {
+  // a long session rolls over many parts, so each one makes room first.
+  Prune();
+
+  char name[64];
+  std::snprintf(name, sizeof(name), "%s.%03d.jsonl",
+                session_id_.c_str(), part_);
+  boost::filesystem::path path{directory_};
+  path /= name;
+  file_.open(path.string(), std::ios::out | std::ios::app);
+}
+
+
+void ObsSessionJournal::Prune() {
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(directory_, ec);
+
+  std::vector<std::pair<std::time_t, boost::filesystem::path>> files;
+  uint64_t total_size{0};
+  for (boost::filesystem::directory_iterator i{directory_, ec}, end;
+       !ec && i != end; i.increment(ec)) {
+    const boost::filesystem::path &path = i->path();
+    if (path.extension() != ".jsonl") {
+      continue;
+    }
+    boost::system::error_code size_ec;
+    const uintmax_t size = boost::filesystem::file_size(path, size_ec);
+    if (size_ec) {
+      continue;
+    }
+    total_size += size;
+    files.emplace_back(boost::filesystem::last_write_time(path, ec), path);
+  }
+  std::sort(files.begin(), files.end());
+
+  // leaves room for a whole new part.
+  for (const auto &file : files) {
+    if (total_size + kMaxFileSize <= kMaxTotalSize) {
+      break;
+    }
+    const uintmax_t size = boost::filesystem::file_size(file.second, ec);
+    if (!ec && boost::filesystem::remove(file.second, ec) == true) {
+      total_size -= size;
+    }
+  }
+}
+
+
+void ObsSessionJournal::CloseFile() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (file_.is_open() == true) {
+    file_.close();
+  }
+  if (cpu_info_) {
+    os_cpu_usage_info_destroy(cpu_info_);
+    cpu_info_ = nullptr;
+  }
+}
+}  // namespace ncstreamer
@@ -0,0 +1,63 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_OBS_OBS_SESSION_JOURNAL_H_
+#define NCSTREAMER_CEF_SRC_OBS_OBS_SESSION_JOURNAL_H_
+
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>  // NOLINT
+#include <string>
+
+#include "boost/property_tree/ptree.hpp"
+#include "obs-studio/libobs/util/platform.h"
+
+#include "ncstreamer_cef/src/obs/obs_output.h"
+#include "ncstreamer_cef/src/obs/obs_stats_sampler.h"
+
+
+namespace ncstreamer {
+// Writes one JSON object per line for each streaming session:
+// "start", a "sample" per second, "reconnect"/"recovered" and "stop".
+// A session rolls over to a new part file past kMaxFileSize, and the
+// oldest files go once the directory passes kMaxTotalSize.
+class ObsSessionJournal {
+ public:
+  static const uint64_t kMaxFileSize{4 * 1024 * 1024};
+  static const uint64_t kMaxTotalSize{64 * 1024 * 1024};
+
+  // an empty directory disables the journal.
+  explicit ObsSessionJournal(const std::string &directory);
+  virtual ~ObsSessionJournal();
+
+  void Open(const boost::property_tree::ptree &session);
+  void WriteSample(const ObsStatsSampler::Sample &sample);
+  void WriteReconnect(int attempt, const std::string &server);
+  void WriteRecovered(int attempts, const std::string &server);
+  void Close(ObsOutput::StopReason reason);
+  // closes a session whose output never started.
+  void Abort();
+
+ private:
+  static const char *ToString(ObsOutput::StopReason reason);
+
+  void Write(const std::string &event, boost::property_tree::ptree *record);
+  void OpenPart();
+  void Prune();
+  void CloseFile();
+
+  const std::string directory_;
+
+  std::mutex mutex_;
+  std::ofstream file_;
+  std::string session_id_;
+  int part_;
+  os_cpu_usage_info_t *cpu_info_;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_OBS_OBS_SESSION_JOURNAL_H_
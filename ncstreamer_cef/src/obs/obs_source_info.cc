@@ -30,4 +30,12 @@ ObsSourceInfo::ObsSourceInfo(const std::string &source)
 
 ObsSourceInfo::~ObsSourceInfo() {
 }
+
+
+std::string ObsSourceInfo::Decode(const char *encoded) {
+  std::string decoded{encoded};
+  boost::replace_all(decoded, "#3A", ":");
+  boost::replace_all(decoded, "#22", "#");
+  return decoded;
+}
 }  // namespace ncstreamer
@@ -16,6 +16,9 @@ class ObsSourceInfo {
   explicit ObsSourceInfo(const std::string &source);
   virtual ~ObsSourceInfo();
 
+  // decodes a property list value escaped by libobs plugins.
+  static std::string Decode(const char *encoded);
+
   const std::string &source() const { return source_; }
   const std::string &title() const { return title_; }
   const std::string &clazz() const { return clazz_; }
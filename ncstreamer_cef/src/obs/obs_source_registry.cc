@@ -0,0 +1,134 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/obs/obs_source_registry.h"
+
+
+namespace ncstreamer {
+ObsSourceRegistry::ObsSourceRegistry()
+    : mutex_{},
+      items_{},
+      filters_{} {
+  items_.fill(nullptr);
+}
+
+
+ObsSourceRegistry::~ObsSourceRegistry() {
+  Clear();
+}
+
+
+void ObsSourceRegistry::SetItem(ItemSlot slot, obs_sceneitem_t *item) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  RemoveItemLocked(slot);
+  obs_sceneitem_addref(item);
+  items_[static_cast<std::size_t>(slot)] = item;
+}
+
+
+void ObsSourceRegistry::SetFilter(
+    FilterSlot slot, obs_source_t *parent, obs_source_t *filter) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  RemoveFilterLocked(slot);
+  obs_source_filter_add(parent, filter);
+
+  obs_source_addref(parent);
+  obs_source_addref(filter);
+  FilterEntry &entry = filters_[static_cast<std::size_t>(slot)];
+  entry.parent = parent;
+  entry.filter = filter;
+}
+
+
+std::shared_ptr<obs_sceneitem_t> ObsSourceRegistry::item(
+    ItemSlot slot) const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  obs_sceneitem_t *found = items_[static_cast<std::size_t>(slot)];
+  if (!found) {
+    return nullptr;
+  }
+  obs_sceneitem_addref(found);
+  return std::shared_ptr<obs_sceneitem_t>{found, obs_sceneitem_release};
+}
+
+
+std::shared_ptr<obs_source_t> ObsSourceRegistry::item_source(
+    ItemSlot slot) const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  obs_sceneitem_t *found = items_[static_cast<std::size_t>(slot)];
+  if (!found) {
+    return nullptr;
+  }
+  obs_source_t *source = obs_sceneitem_get_source(found);
+  obs_source_addref(source);
+  return std::shared_ptr<obs_source_t>{source, obs_source_release};
+}
+
+
+std::shared_ptr<obs_source_t> ObsSourceRegistry::filter(
+    FilterSlot slot) const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  obs_source_t *found = filters_[static_cast<std::size_t>(slot)].filter;
+  if (!found) {
+    return nullptr;
+  }
+  obs_source_addref(found);
+  return std::shared_ptr<obs_source_t>{found, obs_source_release};
+}
+
+
+bool ObsSourceRegistry::RemoveItem(ItemSlot slot) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  return RemoveItemLocked(slot);
+}
+
+
+bool ObsSourceRegistry::RemoveFilter(FilterSlot slot) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  return RemoveFilterLocked(slot);
+}
+
+
+void ObsSourceRegistry::Clear() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  for (std::size_t i = 0; i < filters_.size(); ++i) {
+    RemoveFilterLocked(static_cast<FilterSlot>(i));
+  }
+  for (std::size_t i = 0; i < items_.size(); ++i) {
+    RemoveItemLocked(static_cast<ItemSlot>(i));
+  }
+}
+
+
+bool ObsSourceRegistry::RemoveItemLocked(ItemSlot slot) {
+  obs_sceneitem_t *&item = items_[static_cast<std::size_t>(slot)];
+  if (!item) {
+    return false;
+  }
+  obs_sceneitem_remove(item);
+  obs_sceneitem_release(item);
+  item = nullptr;
+  return true;
+}
+
+
+bool ObsSourceRegistry::RemoveFilterLocked(FilterSlot slot) {
+  FilterEntry &entry = filters_[static_cast<std::size_t>(slot)];
+  if (!entry.filter) {
+    return false;
+  }
+  obs_source_filter_remove(entry.parent, entry.filter);
+  obs_source_release(entry.filter);
+  obs_source_release(entry.parent);
+  entry = FilterEntry{};
+  return true;
+}
+
+
+ObsSourceRegistry::FilterEntry::FilterEntry()
+    : parent{nullptr},
+      filter{nullptr} {
+}
+}  // namespace ncstreamer
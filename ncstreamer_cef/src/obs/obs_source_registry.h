@@ -0,0 +1,74 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_OBS_OBS_SOURCE_REGISTRY_H_
+#define NCSTREAMER_CEF_SRC_OBS_OBS_SOURCE_REGISTRY_H_
+
+
+#include <array>
+#include <memory>
+#include <mutex>  // NOLINT
+
+#include "obs-studio/libobs/obs.h"
+
+
+namespace ncstreamer {
+class ObsSourceRegistry {
+ public:
+  enum class ItemSlot {
+    kWebcam = 0,
+    kWebcamFull,
+    kBrbImage,
+    kBrbText,
+    kCount,
+  };
+
+  enum class FilterSlot {
+    kChromaKey = 0,
+    kMicNoiseGate,
+    kMicNoiseSuppression,
+    kCount,
+  };
+
+  ObsSourceRegistry();
+  virtual ~ObsSourceRegistry();
+
+  // the registry takes its own references; callers keep theirs.
+  void SetItem(ItemSlot slot, obs_sceneitem_t *item);
+  void SetFilter(FilterSlot slot, obs_source_t *parent, obs_source_t *filter);
+
+  // each holds its own reference, so it outlives a removal on another
+  // thread; empty if the slot is empty.
+  std::shared_ptr<obs_sceneitem_t> item(ItemSlot slot) const;
+  std::shared_ptr<obs_source_t> item_source(ItemSlot slot) const;
+  std::shared_ptr<obs_source_t> filter(FilterSlot slot) const;
+
+  bool RemoveItem(ItemSlot slot);
+  bool RemoveFilter(FilterSlot slot);
+  void Clear();
+
+ private:
+  class FilterEntry {
+   public:
+    FilterEntry();
+
+    obs_source_t *parent;
+    obs_source_t *filter;
+  };
+
+  bool RemoveItemLocked(ItemSlot slot);
+  bool RemoveFilterLocked(FilterSlot slot);
+
+  // the UI thread and the websocket thread both turn sources on and off.
+  mutable std::mutex mutex_;
+  std::array<obs_sceneitem_t *,
+             static_cast<std::size_t>(ItemSlot::kCount)> items_;
+  std::array<FilterEntry,
+             static_cast<std::size_t>(FilterSlot::kCount)> filters_;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_OBS_OBS_SOURCE_REGISTRY_H_
@@ -0,0 +1,140 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/obs/obs_stats_sampler.h"
+
+#include <chrono>  // NOLINT
+
+#include "ncstreamer_cef/src/obs/obs_scale_policy.h"
+
+
+namespace ncstreamer {
+ObsStatsSampler::Sample::Sample()
+    : time{0},
+      average_frame_time_ms{0.0},
+      lagged_frames{0},
+      rendered_frames{0},
+      skipped_frames{0},
+      encoded_frames{0},
+      dropped_frames{0},
+      output_frames{0},
+      congestion{0.0f},
+      bitrate{0},
+      scale_type{""},
+      colorspace{""} {
+}
+
+
+ObsStatsSampler::ObsStatsSampler()
+    : samples_{},
+      thread_{},
+      stop_cv_{},
+      mutex_{},
+      stops_{false} {
+}
+
+
+ObsStatsSampler::~ObsStatsSampler() {
+  Stop();
+}
+
+
+boost::property_tree::ptree ObsStatsSampler::ToPtree(
+    const std::vector<Sample> &samples) {
+  boost::property_tree::ptree arr_sample;
+  for (const auto &sample : samples) {
+    boost::property_tree::ptree tree;
+    tree.put("time", sample.time);
+    tree.put("averageFrameTimeMs", sample.average_frame_time_ms);
+    tree.put("laggedFrames", sample.lagged_frames);
+    tree.put("renderedFrames", sample.rendered_frames);
+    tree.put("skippedFrames", sample.skipped_frames);
+    tree.put("encodedFrames", sample.encoded_frames);
+    tree.put("droppedFrames", sample.dropped_frames);
+    tree.put("outputFrames", sample.output_frames);
+    tree.put("congestion", sample.congestion);
+    tree.put("bitrate", sample.bitrate);
+    tree.put("scaleType", sample.scale_type);
+    tree.put("colorspace", sample.colorspace);
+    arr_sample.push_back({"", tree});
+  }
+  return arr_sample;
+}
+
+
+void ObsStatsSampler::Start(
+    const ObsOutput *output, const OnSample &on_sample) {
+  Stop();
+
+  std::lock_guard<std::mutex> lock{mutex_};
+  stops_ = false;
+  thread_ = std::thread{&ObsStatsSampler::Run, this, output, on_sample};
+}
+
+
+void ObsStatsSampler::Stop() {
+  // called from both StopStreaming and the output's stop callback.
+  std::thread thread;
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    stops_ = true;
+    thread.swap(thread_);
+  }
+  if (thread.joinable() == false) {
+    return;
+  }
+  stop_cv_.notify_all();
+  thread.join();
+}
+
+
+std::vector<ObsStatsSampler::Sample> ObsStatsSampler::GetLatest(
+    std::size_t count) const {
+  return samples_.CopyLatest(count);
+}
+
+
+void ObsStatsSampler::Run(
+    const ObsOutput *output, const OnSample &on_sample) {
+  static const std::chrono::seconds kSampleInterval{1};
+
+  const uint32_t base_lagged_frames = obs_get_lagged_frames();
+  const uint32_t base_rendered_frames = obs_get_total_frames();
+  uint64_t last_bytes = output->GetTotalBytes();
+
+  std::unique_lock<std::mutex> lock{mutex_};
+  while (stop_cv_.wait_for(lock, kSampleInterval, [this]() {
+    return stops_;
+  }) == false) {
+    video_t *video = obs_get_video();
+    const uint64_t bytes = output->GetTotalBytes();
+
+    Sample sample;
+    sample.time = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    sample.average_frame_time_ms =
+        obs_get_average_frame_time_ns() / 1000000.0;
+    sample.lagged_frames = obs_get_lagged_frames() - base_lagged_frames;
+    sample.rendered_frames = obs_get_total_frames() - base_rendered_frames;
+    sample.skipped_frames = video_output_get_skipped_frames(video);
+    sample.encoded_frames = video_output_get_total_frames(video);
+    sample.dropped_frames = output->GetDroppedFrames();
+    sample.output_frames = output->GetTotalFrames();
+    sample.congestion = output->GetCongestion();
+    sample.bitrate = static_cast<uint32_t>(
+        (bytes >= last_bytes ? bytes - last_bytes : 0) * 8 / 1000);
+    last_bytes = bytes;
+
+    struct obs_video_info ovi;
+    if (obs_get_video_info(&ovi) == true) {
+      sample.scale_type = ObsScalePolicy::ToString(ovi.scale_type);
+      sample.colorspace = ObsScalePolicy::ToString(ovi.colorspace);
+    }
+
+    samples_.Push(sample);
+    on_sample(sample);
+  }
+}
+}  // namespace ncstreamer
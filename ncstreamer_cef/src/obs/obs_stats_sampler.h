@@ -0,0 +1,77 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_OBS_OBS_STATS_SAMPLER_H_
+#define NCSTREAMER_CEF_SRC_OBS_OBS_STATS_SAMPLER_H_
+
+
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <functional>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "boost/property_tree/ptree.hpp"
+
+#include "ncstreamer_cef/src/lib/ring_buffer.h"
+#include "ncstreamer_cef/src/obs/obs_output.h"
+
+
+namespace ncstreamer {
+class ObsStatsSampler {
+ public:
+  // frame counters are totals since the stream started. the average frame
+  // time includes the GPU scaling, so it is reported with the scaler in use.
+  class Sample {
+   public:
+    Sample();
+
+    int64_t time;  // seconds since epoch.
+    double average_frame_time_ms;
+    uint32_t lagged_frames;
+    uint32_t rendered_frames;
+    uint32_t skipped_frames;
+    uint32_t encoded_frames;
+    int dropped_frames;
+    int output_frames;
+    float congestion;
+    uint32_t bitrate;  // kbps over the last second.
+    const char *scale_type;
+    const char *colorspace;
+  };
+
+  using OnSample = std::function<void(const Sample &sample)>;
+
+  static const std::size_t kMaxSamples{300};
+
+  ObsStatsSampler();
+  virtual ~ObsStatsSampler();
+
+  static boost::property_tree::ptree ToPtree(
+      const std::vector<Sample> &samples);
+
+  void Start(const ObsOutput *output, const OnSample &on_sample);
+  void Stop();
+
+  std::vector<Sample> GetLatest(std::size_t count) const;
+
+ private:
+  void Run(const ObsOutput *output, const OnSample &on_sample);
+
+  RingBuffer<Sample, kMaxSamples> samples_;
+
+  std::thread thread_;
+  std::condition_variable stop_cv_;
+  // This mutex is used for two purposes:
+  // 1) to synchronize accesses to stops_ and thread_
+  // 2) for the condition variable stop_cv_
+  mutable std::mutex mutex_;
+  bool stops_;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_OBS_OBS_STATS_SAMPLER_H_
@@ -0,0 +1,113 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/obs/obs_update_queue.h"
+
+#include <utility>
+
+#include "obs-studio/libobs/obs.h"
+
+
+namespace ncstreamer {
+ObsUpdateQueue::ObsUpdateQueue()
+    : thread_{},
+      posted_cv_{},
+      applied_cv_{},
+      mutex_{},
+      stops_{false},
+      applying_{false},
+      pending_{} {
+  thread_ = std::thread{&ObsUpdateQueue::Run, this};
+}
+
+
+ObsUpdateQueue::~ObsUpdateQueue() {
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    stops_ = true;
+  }
+  posted_cv_.notify_all();
+  thread_.join();
+}
+
+
+void ObsUpdateQueue::Post(Key key, const Update &update) {
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    pending_[static_cast<std::size_t>(key)] = update;
+  }
+  posted_cv_.notify_all();
+}
+
+
+void ObsUpdateQueue::Flush() {
+  std::unique_lock<std::mutex> lock{mutex_};
+  applied_cv_.wait(lock, [this]() {
+    return stops_ || (HasPending() == false && applying_ == false);
+  });
+}
+
+
+void ObsUpdateQueue::Discard(Key key) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  pending_[static_cast<std::size_t>(key)] = nullptr;
+}
+
+
+std::chrono::microseconds ObsUpdateQueue::GetFrameInterval() {
+  static const std::chrono::microseconds kDefaultInterval{33333};
+
+  struct obs_video_info ovi;
+  if (obs_get_video_info(&ovi) == false || ovi.fps_num == 0) {
+    return kDefaultInterval;
+  }
+  return std::chrono::microseconds{
+      1000000ull * ovi.fps_den / ovi.fps_num};
+}
+
+
+void ObsUpdateQueue::Run() {
+  std::unique_lock<std::mutex> lock{mutex_};
+  while (true) {
+    posted_cv_.wait(lock, [this]() {
+      return stops_ || HasPending();
+    });
+    if (stops_) {
+      break;
+    }
+
+    PendingUpdates updates;
+    std::swap(updates, pending_);
+    applying_ = true;
+    lock.unlock();
+
+    for (const auto &update : updates) {
+      if (update) {
+        update();
+      }
+    }
+    const auto next_frame = std::chrono::steady_clock::now() +
+                            GetFrameInterval();
+
+    lock.lock();
+    applying_ = false;
+    applied_cv_.notify_all();
+    posted_cv_.wait_until(lock, next_frame, [this]() {
+      return stops_;
+    });
+  }
+  applied_cv_.notify_all();
+}
+
+
+bool ObsUpdateQueue::HasPending() const {
+  for (const auto &update : pending_) {
+    if (update) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace ncstreamer
@@ -0,0 +1,66 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_OBS_OBS_UPDATE_QUEUE_H_
+#define NCSTREAMER_CEF_SRC_OBS_OBS_UPDATE_QUEUE_H_
+
+
+#include <array>
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
+#include <functional>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+
+
+namespace ncstreamer {
+// Applies setting changes off the caller's thread. Only the latest update
+// per key is kept, and the keys are applied at most once per video frame.
+class ObsUpdateQueue {
+ public:
+  enum class Key {
+    kWebcamPosition = 0,
+    kChromaKeyColor,
+    kChromaKeySimilarity,
+    kMicVolume,
+    kDesktopVolume,
+    kCrop,
+    kCount,
+  };
+
+  using Update = std::function<void()>;
+
+  ObsUpdateQueue();
+  virtual ~ObsUpdateQueue();
+
+  void Post(Key key, const Update &update);
+  // blocks until every update posted so far has been applied.
+  void Flush();
+  void Discard(Key key);
+
+ private:
+  using PendingUpdates =
+      std::array<Update, static_cast<std::size_t>(Key::kCount)>;
+
+  static std::chrono::microseconds GetFrameInterval();
+
+  void Run();
+  bool HasPending() const;
+
+  std::thread thread_;
+  std::condition_variable posted_cv_;
+  std::condition_variable applied_cv_;
+  // This mutex is used for two purposes:
+  // 1) to synchronize accesses to stops_, pending_ and applying_
+  // 2) for the condition variables posted_cv_ and applied_cv_
+  mutable std::mutex mutex_;
+  bool stops_;
+  bool applying_;
+  PendingUpdates pending_;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_OBS_OBS_UPDATE_QUEUE_H_
@@ -0,0 +1,187 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/obs/obs_window_index.h"
+
+#include <algorithm>
+#include <cassert>
+#include <codecvt>
+#include <locale>
+
+
+namespace ncstreamer {
+ObsWindowIndex::ObsWindowIndex()
+    : stop_event_{::CreateEvent(NULL, TRUE, FALSE, NULL)},
+      thread_{},
+      mutex_{},
+      sources_{},
+      generation_{0},
+      snapshot_{std::make_shared<const std::vector<std::string>>()},
+      snapshot_generation_{0} {
+  assert(!static_instance);
+  static_instance = this;
+
+  ::EnumWindows(ObsWindowIndex::OnEnumWindow, 0);
+  thread_ = std::thread{&ObsWindowIndex::Run, this};
+}
+
+
+ObsWindowIndex::~ObsWindowIndex() {
+  ::SetEvent(stop_event_);
+  thread_.join();
+  ::CloseHandle(stop_event_);
+  static_instance = nullptr;
+}
+
+
+ObsWindowIndex::Snapshot ObsWindowIndex::GetSnapshot() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (snapshot_generation_ == generation_) {
+    return snapshot_;
+  }
+
+  auto sources = std::make_shared<std::vector<std::string>>();
+  sources->reserve(sources_.size());
+  for (const auto &source : sources_) {
+    sources->emplace_back(source.second);
+  }
+  std::sort(sources->begin(), sources->end());
+
+  snapshot_ = sources;
+  snapshot_generation_ = generation_;
+  return snapshot_;
+}
+
+
+uint64_t ObsWindowIndex::generation() const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  return generation_;
+}
+
+
+void CALLBACK ObsWindowIndex::OnWinEvent(
+    HWINEVENTHOOK /*hook*/, DWORD event, HWND wnd,
+    LONG id_object, LONG id_child, DWORD /*thread_id*/, DWORD /*time*/) {
+  if (id_object != OBJID_WINDOW || id_child != CHILDID_SELF || !wnd) {
+    return;
+  }
+
+  if (event == EVENT_OBJECT_DESTROY) {
+    static_instance->RemoveWindow(wnd);
+  } else {
+    static_instance->UpdateWindow(wnd);
+  }
+}
+
+
+BOOL CALLBACK ObsWindowIndex::OnEnumWindow(HWND wnd, LPARAM /*param*/) {
+  static_instance->UpdateWindow(wnd);
+  return TRUE;
+}
+
+
+bool ObsWindowIndex::ReadSource(HWND wnd, std::string *source) {
+  if (::GetAncestor(wnd, GA_ROOT) != wnd ||
+      ::IsWindowVisible(wnd) == FALSE) {
+    return false;
+  }
+  const LONG_PTR styles = ::GetWindowLongPtr(wnd, GWL_STYLE);
+  const LONG_PTR ex_styles = ::GetWindowLongPtr(wnd, GWL_EXSTYLE);
+  if ((styles & WS_CHILD) != 0 || (ex_styles & WS_EX_TOOLWINDOW) != 0) {
+    return false;
+  }
+
+  DWORD process_id{0};
+  ::GetWindowThreadProcessId(wnd, &process_id);
+  if (process_id == ::GetCurrentProcessId()) {
+    return false;
+  }
+
+  wchar_t title[256];
+  if (::GetWindowTextW(wnd, title, _countof(title)) == 0) {
+    return false;
+  }
+  wchar_t clazz[256];
+  if (::GetClassNameW(wnd, clazz, _countof(clazz)) == 0) {
+    return false;
+  }
+
+  HANDLE process = ::OpenProcess(
+      PROCESS_QUERY_LIMITED_INFORMATION, FALSE, process_id);
+  if (!process) {
+    return false;
+  }
+  wchar_t path[MAX_PATH];
+  DWORD path_size{_countof(path)};
+  BOOL queried = ::QueryFullProcessImageNameW(process, 0, path, &path_size);
+  ::CloseHandle(process);
+  if (queried == FALSE) {
+    return false;
+  }
+  const wchar_t *exe = wcsrchr(path, L'\\');
+  exe = exe ? exe + 1 : path;
+
+  static std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
+  *source = converter.to_bytes(title) + ":" +
+            converter.to_bytes(clazz) + ":" +
+            converter.to_bytes(exe);
+  return true;
+}
+
+
+void ObsWindowIndex::Run() {
+  HWINEVENTHOOK lifetime_hook = ::SetWinEventHook(
+      EVENT_OBJECT_CREATE, EVENT_OBJECT_HIDE, NULL,
+      ObsWindowIndex::OnWinEvent, 0, 0,
+      WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+  HWINEVENTHOOK name_hook = ::SetWinEventHook(
+      EVENT_OBJECT_NAMECHANGE, EVENT_OBJECT_NAMECHANGE, NULL,
+      ObsWindowIndex::OnWinEvent, 0, 0,
+      WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+
+  while (::MsgWaitForMultipleObjects(
+      1, &stop_event_, FALSE, INFINITE, QS_ALLINPUT) != WAIT_OBJECT_0) {
+    MSG msg;
+    while (::PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
+      ::TranslateMessage(&msg);
+      ::DispatchMessage(&msg);
+    }
+  }
+
+  ::UnhookWinEvent(name_hook);
+  ::UnhookWinEvent(lifetime_hook);
+}
+
+
+void ObsWindowIndex::UpdateWindow(HWND wnd) {
+  std::string source;
+  if (ReadSource(wnd, &source) == false) {
+    RemoveWindow(wnd);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock{mutex_};
+  auto i = sources_.find(wnd);
+  if (i == sources_.end()) {
+    sources_.emplace(wnd, source);
+  } else if (i->second != source) {
+    i->second.swap(source);
+  } else {
+    return;
+  }
+  ++generation_;
+}
+
+
+void ObsWindowIndex::RemoveWindow(HWND wnd) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (sources_.erase(wnd) != 0) {
+    ++generation_;
+  }
+}
+
+
+ObsWindowIndex *ObsWindowIndex::static_instance{nullptr};
+}  // namespace ncstreamer
@@ -0,0 +1,60 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_OBS_OBS_WINDOW_INDEX_H_
+#define NCSTREAMER_CEF_SRC_OBS_OBS_WINDOW_INDEX_H_
+
+
+#include <cstdint>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <unordered_map>
+#include <vector>
+
+#include "windows.h"  // NOLINT
+
+
+namespace ncstreamer {
+// Keeps the top-level windows a game capture source can hook, updated from
+// window create/destroy/show/hide/rename events.
+class ObsWindowIndex {
+ public:
+  using Snapshot = std::shared_ptr<const std::vector<std::string>>;
+
+  ObsWindowIndex();
+  virtual ~ObsWindowIndex();
+
+  // "title:class:exe" of each window, in the same form ObsSourceInfo parses.
+  Snapshot GetSnapshot();
+  uint64_t generation() const;
+
+ private:
+  static void CALLBACK OnWinEvent(
+      HWINEVENTHOOK hook, DWORD event, HWND wnd,
+      LONG id_object, LONG id_child, DWORD thread_id, DWORD time);
+  static BOOL CALLBACK OnEnumWindow(HWND wnd, LPARAM param);
+  static bool ReadSource(HWND wnd, std::string *source);
+
+  void Run();
+  void UpdateWindow(HWND wnd);
+  void RemoveWindow(HWND wnd);
+
+  static ObsWindowIndex *static_instance;
+
+  HANDLE stop_event_;
+  std::thread thread_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<HWND, std::string> sources_;
+  uint64_t generation_;
+  Snapshot snapshot_;
+  uint64_t snapshot_generation_;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_OBS_OBS_WINDOW_INDEX_H_
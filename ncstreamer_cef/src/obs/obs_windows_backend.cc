@@ -0,0 +1,84 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/obs/obs_windows_backend.h"
+
+#include "ncstreamer_cef/src/obs/obs_resolution_watcher.h"
+
+
+namespace ncstreamer {
+ObsWindowsBackend::ObsWindowsBackend() {
+}
+
+
+ObsWindowsBackend::~ObsWindowsBackend() {
+}
+
+
+const char *ObsWindowsBackend::graphics_module() const {
+  return "libobs-d3d11.dll";
+}
+
+
+const std::unordered_set<std::string> &ObsWindowsBackend::modules() const {
+  static const std::unordered_set<std::string> kModules{
+      "win-capture",
+      "win-dshow",
+      "win-wasapi",
+      "obs-x264",
+      "obs-ffmpeg",
+      "win-mf",
+      "obs-outputs",
+      "rtmp-services",
+      "obs-filters",
+      "obs-transitions",
+      "image-source",
+      "obs-text"};
+  return kModules;
+}
+
+
+ObsDeviceCatalog::Notification
+    ObsWindowsBackend::device_notification() const {
+  return ObsDeviceCatalog::Notification::kDeviceChange;
+}
+
+
+const char *ObsWindowsBackend::game_source_id() const {
+  return "game_capture";
+}
+
+
+const char *ObsWindowsBackend::webcam_source_id() const {
+  return "dshow_input";
+}
+
+
+const char *ObsWindowsBackend::mic_source_id() const {
+  return "wasapi_input_capture";
+}
+
+
+const char *ObsWindowsBackend::desktop_audio_source_id() const {
+  return "wasapi_output_capture";
+}
+
+
+const char *ObsWindowsBackend::image_source_id() const {
+  return "image_source";
+}
+
+
+const char *ObsWindowsBackend::text_source_id() const {
+  return "text_gdiplus";
+}
+
+
+Dimension<uint32_t> ObsWindowsBackend::GetSourceSize(
+    const std::string &source_info, obs_source_t * /*source*/) const {
+  // game capture has no size until it hooks, so the window is measured.
+  return ObsResolutionWatcher::GetWindowSize(source_info);
+}
+}  // namespace ncstreamer
@@ -0,0 +1,40 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_OBS_OBS_WINDOWS_BACKEND_H_
+#define NCSTREAMER_CEF_SRC_OBS_OBS_WINDOWS_BACKEND_H_
+
+
+#include <string>
+#include <unordered_set>
+
+#include "ncstreamer_cef/src/obs/obs_backend.h"
+
+
+namespace ncstreamer {
+// Direct3D 11 with game capture, DirectShow and WASAPI.
+class ObsWindowsBackend : public ObsBackend {
+ public:
+  ObsWindowsBackend();
+  virtual ~ObsWindowsBackend();
+
+  const char *graphics_module() const override;
+  const std::unordered_set<std::string> &modules() const override;
+  ObsDeviceCatalog::Notification device_notification() const override;
+
+  const char *game_source_id() const override;
+  const char *webcam_source_id() const override;
+  const char *mic_source_id() const override;
+  const char *desktop_audio_source_id() const override;
+  const char *image_source_id() const override;
+  const char *text_source_id() const override;
+
+  Dimension<uint32_t> GetSourceSize(
+      const std::string &source_info, obs_source_t *source) const override;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_OBS_OBS_WINDOWS_BACKEND_H_
@@ -20,8 +20,20 @@ class RemoteMessage {
     kStreamingStopRequest = 211,
     kStreamingStopResponse,
     kStreamingStopEvent,
+    kStreamingReconnectEvent = 221,
+    kStreamingRecoveredEvent,
+    kStreamingSimulcastAddRequest = 231,
+    kStreamingSimulcastAddResponse,
+    kStreamingSimulcastStartEvent,
+    kStreamingSimulcastRemoveRequest = 241,
+    kStreamingSimulcastRemoveResponse,
+    kStreamingSimulcastStopEvent,
     kSettingsQualityUpdateRequest = 301,
     kSettingsQualityUpdateResponse,
+    kSettingsStreamDelayRequest = 311,
+    kSettingsStreamDelayResponse,
+    kSettingsCropRequest = 321,
+    kSettingsCropResponse,
     kStreamingCommentsRequest = 401,
     kStreamingCommentsResponse,
     kSettingsWebcamSearchRequest = 501,
@@ -52,8 +64,22 @@ class RemoteMessage {
     kNcStreamerUrlUpdateResponse,
     kStreamingViewersRequest = 801,
     kStreamingViewersResponse,
+    kStreamingStatsRequest = 811,
+    kStreamingStatsResponse,
     kNcStreamerExitRequest = 901,
     kNcStreamerExitResponse,  // not used.
+    kScenesRequest = 1001,
+    kScenesResponse,
+    kSceneSwitchRequest = 1011,
+    kSceneSwitchResponse,
+    kSceneBrbUpdateRequest = 1021,
+    kSceneBrbUpdateResponse,
+    kRecordingStartRequest = 1101,
+    kRecordingStartResponse,
+    kRecordingSaveRequest = 1111,
+    kRecordingSaveResponse,
+    kRecordingStopRequest = 1121,
+    kRecordingStopResponse,
   };
 };
 }  // namespace ncstreamer
@@ -192,6 +192,32 @@ void RemoteServer::NotifySettingsQualityUpdate(
 }
 
 
+void RemoteServer::NotifyStreamingReconnect(
+    int attempt,
+    int64_t delay_ms,
+    const std::string &stream_server) {
+  boost::property_tree::ptree tree;
+  tree.put("type", static_cast<int>(
+      RemoteMessage::MessageType::kStreamingReconnectEvent));
+  tree.put("attempt", attempt);
+  tree.put("delay", delay_ms);
+  tree.put("streamServer", stream_server);
+  PostBroadcast(tree);
+}
+
+
+void RemoteServer::NotifyStreamingRecovered(
+    int attempts,
+    const std::string &stream_server) {
+  boost::property_tree::ptree tree;
+  tree.put("type", static_cast<int>(
+      RemoteMessage::MessageType::kStreamingRecoveredEvent));
+  tree.put("attempts", attempts);
+  tree.put("streamServer", stream_server);
+  PostBroadcast(tree);
+}
+
+
 std::size_t RemoteServer::ConnectionHasher::operator()(
     const websocketpp::connection_hdl &connection) const {
   return reinterpret_cast<std::size_t>(connection.lock().get());
@@ -366,15 +392,48 @@ void RemoteServer::OnMessage(
       {RemoteMessage::MessageType::kStreamingStopRequest,
        std::bind(&RemoteServer::OnStreamingStopRequest,
            this, std::placeholders::_1, std::placeholders::_2)},
+      {RemoteMessage::MessageType::kStreamingSimulcastAddRequest,
+       std::bind(&RemoteServer::OnStreamingSimulcastAddRequest,
+           this, std::placeholders::_1, std::placeholders::_2)},
+      {RemoteMessage::MessageType::kStreamingSimulcastRemoveRequest,
+       std::bind(&RemoteServer::OnStreamingSimulcastRemoveRequest,
+           this, std::placeholders::_1, std::placeholders::_2)},
       {RemoteMessage::MessageType::kSettingsQualityUpdateRequest,
        std::bind(&RemoteServer::OnSettingsQualityUpdateRequest,
            this, std::placeholders::_1, std::placeholders::_2)},
+      {RemoteMessage::MessageType::kSettingsStreamDelayRequest,
+       std::bind(&RemoteServer::OnSettingsStreamDelayRequest,
+           this, std::placeholders::_1, std::placeholders::_2)},
+      {RemoteMessage::MessageType::kSettingsCropRequest,
+       std::bind(&RemoteServer::OnSettingsCropRequest,
+           this, std::placeholders::_1, std::placeholders::_2)},
       {RemoteMessage::MessageType::kStreamingCommentsRequest,
        std::bind(&RemoteServer::OnCommentsRequest,
            this, std::placeholders::_1, std::placeholders::_2)},
       {RemoteMessage::MessageType::kStreamingViewersRequest,
        std::bind(&RemoteServer::OnViewersRequest,
            this, std::placeholders::_1, std::placeholders::_2) },
+      {RemoteMessage::MessageType::kStreamingStatsRequest,
+       std::bind(&RemoteServer::OnStatsRequest,
+           this, std::placeholders::_1, std::placeholders::_2)},
+      {RemoteMessage::MessageType::kScenesRequest,
+       std::bind(&RemoteServer::OnScenesRequest,
+           this, std::placeholders::_1, std::placeholders::_2)},
+      {RemoteMessage::MessageType::kSceneSwitchRequest,
+       std::bind(&RemoteServer::OnSceneSwitchRequest,
+           this, std::placeholders::_1, std::placeholders::_2)},
+      {RemoteMessage::MessageType::kSceneBrbUpdateRequest,
+       std::bind(&RemoteServer::OnSceneBrbUpdateRequest,
+           this, std::placeholders::_1, std::placeholders::_2)},
+      {RemoteMessage::MessageType::kRecordingStartRequest,
+       std::bind(&RemoteServer::OnRecordingStartRequest,
+           this, std::placeholders::_1, std::placeholders::_2)},
+      {RemoteMessage::MessageType::kRecordingSaveRequest,
+       std::bind(&RemoteServer::OnRecordingSaveRequest,
+           this, std::placeholders::_1, std::placeholders::_2)},
+      {RemoteMessage::MessageType::kRecordingStopRequest,
+       std::bind(&RemoteServer::OnRecordingStopRequest,
+           this, std::placeholders::_1, std::placeholders::_2)},
       {RemoteMessage::MessageType::kSettingsWebcamSearchRequest,
        std::bind(&RemoteServer::OnSettingsWebcamSearchRequest,
            this, std::placeholders::_1, std::placeholders::_2)},
@@ -485,6 +544,67 @@ void RemoteServer::OnStreamingStopRequest(
 }
 
 
+void RemoteServer::OnStreamingSimulcastAddRequest(
+    const websocketpp::connection_hdl &connection,
+    const boost::property_tree::ptree &tree) {
+  std::string error{};
+  std::string id{};
+  std::string service_provider{};
+  std::string stream_server{};
+  std::string stream_key{};
+  try {
+    id = tree.get<std::string>("id");
+    service_provider = tree.get<std::string>("serviceProvider");
+    stream_server = tree.get<std::string>("streamServer");
+    stream_key = tree.get<std::string>("streamKey");
+  } catch (const std::exception &/*e*/) {
+    error = "simulcast add error";
+  }
+
+  if (id.empty() || stream_server.empty()) {
+    error = "simulcast add error";
+  }
+
+  int request_key = request_cache_.CheckIn(connection);
+
+  if (error.empty() == true &&
+      Obs::Get()->AddSimulcastOutput(
+          id,
+          service_provider,
+          stream_server,
+          stream_key,
+          [this, id]() {
+        NotifyStreamingSimulcastStart(id);
+      }, [this, id](ObsOutput::StopReason reason) {
+        NotifyStreamingSimulcastStop(id, reason);
+      }) == false) {
+    error = "not streaming or output busy";
+  }
+
+  if (error.empty() == false) {
+    LogError("OnStreamingSimulcastAdd: " + error);
+  }
+  RespondStreamingSimulcastAdd(request_key, error, id);
+}
+
+
+void RemoteServer::OnStreamingSimulcastRemoveRequest(
+    const websocketpp::connection_hdl &connection,
+    const boost::property_tree::ptree &tree) {
+  const std::string &id = tree.get("id", "");
+
+  int request_key = request_cache_.CheckIn(connection);
+
+  std::string error{};
+  if (id.empty() == true ||
+      Obs::Get()->RemoveSimulcastOutput(id) == false) {
+    error = "unknown simulcast output";
+    LogError("OnStreamingSimulcastRemove: " + error);
+  }
+  RespondStreamingSimulcastRemove(request_key, error, id);
+}
+
+
 void RemoteServer::OnSettingsQualityUpdateRequest(
     const websocketpp::connection_hdl &connection,
     const boost::property_tree::ptree &tree) {
@@ -507,6 +627,82 @@ void RemoteServer::OnSettingsQualityUpdateRequest(
 }
 
 
+void RemoteServer::OnSettingsStreamDelayRequest(
+    const websocketpp::connection_hdl &connection,
+    const boost::property_tree::ptree &tree) {
+  std::string error{};
+  int delay{0};
+  try {
+    delay = tree.get<int>("delay");
+  } catch (const std::exception &/*e*/) {
+    error = "stream delay error";
+  }
+
+  if (delay > 120 || delay < 0) {
+    error = "stream delay error";
+  }
+
+  int request_key = request_cache_.CheckIn(connection);
+
+  if (error.empty() == false) {
+    LogError("OnSettingsStreamDelay: " + error);
+    RespondSettingsStreamDelay(request_key, error, 0, 0);
+    return;
+  }
+
+  const uint32_t applied_delay = Obs::Get()->UpdateStreamDelay(delay);
+
+  boost::property_tree::ptree args;
+  args.add("delay", applied_delay);
+  JsExecutor::Execute(
+      browser_,
+      "remote.onSettingsStreamDelayRequest",
+      args);
+  RespondSettingsStreamDelay(
+      request_key,
+      error,
+      applied_delay,
+      Obs::Get()->GetStreamDelayBufferSize());
+}
+
+
+void RemoteServer::OnSettingsCropRequest(
+    const websocketpp::connection_hdl &connection,
+    const boost::property_tree::ptree &tree) {
+  std::string error{};
+  float x{0.0f};
+  float y{0.0f};
+  float width{1.0f};
+  float height{1.0f};
+  try {
+    x = tree.get<float>("normal_x");
+    y = tree.get<float>("normal_y");
+    width = tree.get<float>("normal_width");
+    height = tree.get<float>("normal_height");
+  } catch (const std::exception &/*e*/) {
+    error = "crop error";
+  }
+
+  if (x < 0.0 || y < 0.0 ||
+      width <= 0.0 || height <= 0.0 ||
+      x + width > 1.0 || y + height > 1.0) {
+    error = "crop error";
+  }
+
+  int request_key = request_cache_.CheckIn(connection);
+
+  if (error.empty() == false) {
+    LogError("OnSettingsCrop: " + error);
+    RespondSettingsCrop(request_key, error);
+    return;
+  }
+
+  Obs::Get()->UpdateCrop(
+      Position<float>{x, y}, Dimension<float>{width, height});
+  RespondSettingsCrop(request_key, error);
+}
+
+
 void RemoteServer::OnCommentsRequest(
   const websocketpp::connection_hdl &connection,
   const boost::property_tree::ptree &tree) {
@@ -541,11 +737,173 @@ void RemoteServer::OnViewersRequest(
 }
 
 
+void RemoteServer::OnStatsRequest(
+    const websocketpp::connection_hdl &connection,
+    const boost::property_tree::ptree &tree) {
+  const std::size_t count = tree.get<std::size_t>(
+      "count", ObsStatsSampler::kMaxSamples);
+
+  int request_key = request_cache_.CheckIn(connection);
+
+  RespondStreamingStats(
+      request_key, "", Obs::Get()->GetStreamingStats(count));
+}
+
+
+void RemoteServer::OnScenesRequest(
+    const websocketpp::connection_hdl &connection,
+    const boost::property_tree::ptree &tree) {
+  int request_key = request_cache_.CheckIn(connection);
+
+  RespondScenes(
+      request_key,
+      "",
+      Obs::Get()->GetSceneNames(),
+      Obs::Get()->GetCurrentScene());
+}
+
+
+void RemoteServer::OnSceneSwitchRequest(
+    const websocketpp::connection_hdl &connection,
+    const boost::property_tree::ptree &tree) {
+  static const uint32_t kMaxTransitionMs{5000};
+
+  std::string error{};
+  std::string scene{};
+  std::string transition{};
+  uint32_t duration{0};
+  try {
+    scene = tree.get<std::string>("scene");
+    transition = tree.get<std::string>("transition", "");
+    duration = tree.get<uint32_t>("duration", 300);
+  } catch (const std::exception &/*e*/) {
+    error = "scene switch error";
+  }
+
+  if (duration > kMaxTransitionMs) {
+    error = "scene switch error";
+  }
+
+  int request_key = request_cache_.CheckIn(connection);
+
+  if (error.empty() == true &&
+      Obs::Get()->SwitchScene(scene, transition, duration) == false) {
+    error = "unknown scene or transition";
+  }
+
+  if (error.empty() == false) {
+    LogError("OnSceneSwitch: " + error);
+  }
+  RespondSceneSwitch(request_key, error, Obs::Get()->GetCurrentScene());
+}
+
+
+void RemoteServer::OnSceneBrbUpdateRequest(
+    const websocketpp::connection_hdl &connection,
+    const boost::property_tree::ptree &tree) {
+  std::string error{};
+  std::string image{};
+  std::string text{};
+  try {
+    image = tree.get<std::string>("image", "");
+    text = tree.get<std::string>("text");
+  } catch (const std::exception &/*e*/) {
+    error = "brb update error";
+  }
+
+  int request_key = request_cache_.CheckIn(connection);
+
+  if (error.empty() == true &&
+      Obs::Get()->UpdateBrbScene(image, text) == false) {
+    error = "no brb scene";
+  }
+
+  if (error.empty() == false) {
+    LogError("OnSceneBrbUpdate: " + error);
+  }
+  RespondSceneBrbUpdate(request_key, error);
+}
+
+
+void RemoteServer::OnRecordingStartRequest(
+    const websocketpp::connection_hdl &connection,
+    const boost::property_tree::ptree &tree) {
+  std::string error{};
+  std::string mode{};
+  std::string directory{};
+  std::string format{};
+  uint32_t max_size_mb{0};
+  uint32_t max_time_sec{0};
+  try {
+    mode = tree.get<std::string>("mode", "file");
+    directory = tree.get<std::string>("directory");
+    format = tree.get<std::string>("format", "mp4");
+    max_size_mb = tree.get<uint32_t>("maxSize", 0);
+    max_time_sec = tree.get<uint32_t>("maxTime", 0);
+  } catch (const std::exception &/*e*/) {
+    error = "recording start error";
+  }
+
+  if (directory.empty() ||
+      (mode != "file" && mode != "replay") ||
+      (format != "mp4" && format != "flv" && format != "mkv")) {
+    error = "recording start error";
+  }
+
+  int request_key = request_cache_.CheckIn(connection);
+
+  if (error.empty() == true) {
+    const bool started = (mode == "file") ?
+        Obs::Get()->StartRecording(
+            directory, format, max_size_mb, max_time_sec) :
+        Obs::Get()->StartReplayBuffer(
+            directory, format, max_size_mb, max_time_sec);
+    if (started == false) {
+      error = "not streaming or recording failed";
+    }
+  }
+
+  if (error.empty() == false) {
+    LogError("OnRecordingStart: " + error);
+  }
+  RespondRecordingStart(request_key, error);
+}
+
+
+void RemoteServer::OnRecordingSaveRequest(
+    const websocketpp::connection_hdl &connection,
+    const boost::property_tree::ptree &/*tree*/) {
+  int request_key = request_cache_.CheckIn(connection);
+
+  std::string error{};
+  if (Obs::Get()->SaveReplayBuffer() == false) {
+    error = "replay buffer not running";
+    LogError("OnRecordingSave: " + error);
+  }
+  RespondRecordingSave(request_key, error);
+}
+
+
+void RemoteServer::OnRecordingStopRequest(
+    const websocketpp::connection_hdl &connection,
+    const boost::property_tree::ptree &/*tree*/) {
+  int request_key = request_cache_.CheckIn(connection);
+
+  Obs::Get()->StopRecording();
+  RespondRecordingStop(request_key, "");
+}
+
+
 void RemoteServer::OnSettingsWebcamSearchRequest(
     const websocketpp::connection_hdl &connection,
     const boost::property_tree::ptree &tree) {
   int request_key = request_cache_.CheckIn(connection);
 
+  if (Obs::Get()->IsReady() == false) {
+    RespondSettingsWebcamSearch(request_key, "not ready", {});
+    return;
+  }
+
   const std::vector<std::string> &webcams{
       Obs::Get()->FindAllWebcamDevices()};
   RespondSettingsWebcamSearch(request_key, "", webcams);
@@ -849,6 +1207,11 @@ void RemoteServer::OnSettingsMicSearchRequest(
       const boost::property_tree::ptree &tree) {
   int request_key = request_cache_.CheckIn(connection);
 
+  if (Obs::Get()->IsReady() == false) {
+    RespondSettingsMicSearch(request_key, "not ready", {});
+    return;
+  }
+
   const std::unordered_map<std::string, std::string> &mic_devices{
       Obs::Get()->SearchMicDevices()};
   RespondSettingsMicSearch(request_key, "", mic_devices);
@@ -1008,6 +1371,70 @@ bool RemoteServer::RespondStreamingStop(
 }
 
 
+bool RemoteServer::RespondStreamingSimulcastAdd(
+    int request_key,
+    const std::string &error,
+    const std::string &id) {
+  websocketpp::connection_hdl connection = request_cache_.CheckOut(request_key);
+  if (!connection.lock()) {
+    LogWarning("RespondStreamingSimulcastAdd: !connection.lock()");
+    return false;
+  }
+
+  std::stringstream msg;
+  {
+    boost::property_tree::ptree tree;
+    tree.put("type", static_cast<int>(
+        RemoteMessage::MessageType::kStreamingSimulcastAddResponse));
+    tree.put("error", error);
+    tree.put("id", id);
+
+    boost::property_tree::write_json(msg, tree, false);
+  }
+
+  websocketpp::lib::error_code ec;
+  server_.send(connection, msg.str(), websocketpp::frame::opcode::text, ec);
+  if (ec) {
+    LogError(ec.message());
+    return false;
+  }
+
+  return true;
+}
+
+
+bool RemoteServer::RespondStreamingSimulcastRemove(
+    int request_key,
+    const std::string &error,
+    const std::string &id) {
+  websocketpp::connection_hdl connection = request_cache_.CheckOut(request_key);
+  if (!connection.lock()) {
+    LogWarning("RespondStreamingSimulcastRemove: !connection.lock()");
+    return false;
+  }
+
+  std::stringstream msg;
+  {
+    boost::property_tree::ptree tree;
+    tree.put("type", static_cast<int>(
+        RemoteMessage::MessageType::kStreamingSimulcastRemoveResponse));
+    tree.put("error", error);
+    tree.put("id", id);
+
+    boost::property_tree::write_json(msg, tree, false);
+  }
+
+  websocketpp::lib::error_code ec;
+  server_.send(connection, msg.str(), websocketpp::frame::opcode::text, ec);
+  if (ec) {
+    LogError(ec.message());
+    return false;
+  }
+
+  return true;
+}
+
+
 bool RemoteServer::RespondSettingsQualityUpdate(
     int request_key,
     const std::string &error) {
@@ -1037,6 +1464,294 @@ bool RemoteServer::RespondSettingsQualityUpdate(
 }
 
 
+bool RemoteServer::RespondSettingsStreamDelay(
+    int request_key,
+    const std::string &error,
+    uint32_t delay,
+    uint64_t buffer_size) {
+  websocketpp::connection_hdl connection = request_cache_.CheckOut(request_key);
+  if (!connection.lock()) {
+    LogWarning("RespondSettingsStreamDelay: !connection.lock()");
+    return false;
+  }
+
+  std::stringstream msg;
+  {
+    boost::property_tree::ptree tree;
+    tree.put("type", static_cast<int>(
+        RemoteMessage::MessageType::kSettingsStreamDelayResponse));
+    tree.put("error", error);
+    tree.put("delay", delay);
+    tree.put("bufferSize", buffer_size);
+
+    boost::property_tree::write_json(msg, tree, false);
+  }
+
+  websocketpp::lib::error_code ec;
+  server_.send(connection, msg.str(), websocketpp::frame::opcode::text, ec);
+  if (ec) {
+    LogError(ec.message());
+    return false;
+  }
+
+  return true;
+}
+
+
+bool RemoteServer::RespondSettingsCrop(
+    int request_key,
+    const std::string &error) {
+  websocketpp::connection_hdl connection = request_cache_.CheckOut(request_key);
+  if (!connection.lock()) {
+    LogWarning("RespondSettingsCrop: !connection.lock()");
+    return false;
+  }
+
+  std::stringstream msg;
+  {
+    boost::property_tree::ptree tree;
+    tree.put("type", static_cast<int>(
+        RemoteMessage::MessageType::kSettingsCropResponse));
+    tree.put("error", error);
+
+    boost::property_tree::write_json(msg, tree, false);
+  }
+
+  websocketpp::lib::error_code ec;
+  server_.send(connection, msg.str(), websocketpp::frame::opcode::text, ec);
+  if (ec) {
+    LogError(ec.message());
+    return false;
+  }
+
+  return true;
+}
+
+
+bool RemoteServer::RespondStreamingStats(
+    int request_key,
+    const std::string &error,
+    const std::vector<ObsStatsSampler::Sample> &samples) {
+  websocketpp::connection_hdl connection = request_cache_.CheckOut(request_key);
+  if (!connection.lock()) {
+    LogWarning("RespondStreamingStats: !connection.lock()");
+    return false;
+  }
+
+  std::stringstream msg;
+  {
+    boost::property_tree::ptree tree;
+    tree.put("type", static_cast<int>(
+        RemoteMessage::MessageType::kStreamingStatsResponse));
+    tree.put("error", error);
+    tree.add_child("stats", ObsStatsSampler::ToPtree(samples));
+    boost::property_tree::write_json(msg, tree, false);
+  }
+
+  websocketpp::lib::error_code ec;
+  server_.send(connection, msg.str(), websocketpp::frame::opcode::text, ec);
+  if (ec) {
+    LogError(ec.message());
+    return false;
+  }
+
+  return true;
+}
+
+
+bool RemoteServer::RespondScenes(
+    int request_key,
+    const std::string &error,
+    const std::vector<std::string> &scenes,
+    const std::string &current) {
+  websocketpp::connection_hdl connection = request_cache_.CheckOut(request_key);
+  if (!connection.lock()) {
+    LogWarning("RespondScenes: !connection.lock()");
+    return false;
+  }
+
+  std::stringstream msg;
+  {
+    std::vector<boost::property_tree::ptree> tree_scenes;
+    for (const auto &scene : scenes) {
+      boost::property_tree::ptree tree;
+      tree.put("name", scene);
+      tree_scenes.emplace_back(tree);
+    }
+
+    boost::property_tree::ptree tree;
+    tree.put("type", static_cast<int>(
+        RemoteMessage::MessageType::kScenesResponse));
+    tree.put("error", error);
+    tree.add_child("sceneList", JsExecutor::ToPtree(tree_scenes));
+    tree.put("current", current);
+
+    boost::property_tree::write_json(msg, tree, false);
+  }
+
+  websocketpp::lib::error_code ec;
+  server_.send(connection, msg.str(), websocketpp::frame::opcode::text, ec);
+  if (ec) {
+    LogError(ec.message());
+    return false;
+  }
+
+  return true;
+}
+
+
+bool RemoteServer::RespondSceneSwitch(
+    int request_key,
+    const std::string &error,
+    const std::string &current) {
+  websocketpp::connection_hdl connection = request_cache_.CheckOut(request_key);
+  if (!connection.lock()) {
+    LogWarning("RespondSceneSwitch: !connection.lock()");
+    return false;
+  }
+
+  std::stringstream msg;
+  {
+    boost::property_tree::ptree tree;
+    tree.put("type", static_cast<int>(
+        RemoteMessage::MessageType::kSceneSwitchResponse));
+    tree.put("error", error);
+    tree.put("current", current);
+
+    boost::property_tree::write_json(msg, tree, false);
+  }
+
+  websocketpp::lib::error_code ec;
+  server_.send(connection, msg.str(), websocketpp::frame::opcode::text, ec);
+  if (ec) {
+    LogError(ec.message());
+    return false;
+  }
+
+  return true;
+}
+
+
+bool RemoteServer::RespondSceneBrbUpdate(
+    int request_key,
+    const std::string &error) {
+  websocketpp::connection_hdl connection = request_cache_.CheckOut(request_key);
+  if (!connection.lock()) {
+    LogWarning("RespondSceneBrbUpdate: !connection.lock()");
+    return false;
+  }
+
+  std::stringstream msg;
+  {
+    boost::property_tree::ptree tree;
+    tree.put("type", static_cast<int>(
+        RemoteMessage::MessageType::kSceneBrbUpdateResponse));
+    tree.put("error", error);
+
+    boost::property_tree::write_json(msg, tree, false);
+  }
+
+  websocketpp::lib::error_code ec;
+  server_.send(connection, msg.str(), websocketpp::frame::opcode::text, ec);
+  if (ec) {
+    LogError(ec.message());
+    return false;
+  }
+
+  return true;
+}
+
+
+bool RemoteServer::RespondRecordingStart(
+    int request_key,
+    const std::string &error) {
+  websocketpp::connection_hdl connection = request_cache_.CheckOut(request_key);
+  if (!connection.lock()) {
+    LogWarning("RespondRecordingStart: !connection.lock()");
+    return false;
+  }
+
+  std::stringstream msg;
+  {
+    boost::property_tree::ptree tree;
+    tree.put("type", static_cast<int>(
+        RemoteMessage::MessageType::kRecordingStartResponse));
+    tree.put("error", error);
+
+    boost::property_tree::write_json(msg, tree, false);
+  }
+
+  websocketpp::lib::error_code ec;
+  server_.send(connection, msg.str(), websocketpp::frame::opcode::text, ec);
+  if (ec) {
+    LogError(ec.message());
+    return false;
+  }
+
+  return true;
+}
+
+
+bool RemoteServer::RespondRecordingSave(
+    int request_key,
+    const std::string &error) {
+  websocketpp::connection_hdl connection = request_cache_.CheckOut(request_key);
+  if (!connection.lock()) {
+    LogWarning("RespondRecordingSave: !connection.lock()");
+    return false;
+  }
+
+  std::stringstream msg;
+  {
+    boost::property_tree::ptree tree;
+    tree.put("type", static_cast<int>(
+        RemoteMessage::MessageType::kRecordingSaveResponse));
+    tree.put("error", error);
+
+    boost::property_tree::write_json(msg, tree, false);
+  }
+
+  websocketpp::lib::error_code ec;
+  server_.send(connection, msg.str(), websocketpp::frame::opcode::text, ec);
+  if (ec) {
+    LogError(ec.message());
+    return false;
+  }
+
+  return true;
+}
+
+
+bool RemoteServer::RespondRecordingStop(
+    int request_key,
+    const std::string &error) {
+  websocketpp::connection_hdl connection = request_cache_.CheckOut(request_key);
+  if (!connection.lock()) {
+    LogWarning("RespondRecordingStop: !connection.lock()");
+    return false;
+  }
+
+  std::stringstream msg;
+  {
+    boost::property_tree::ptree tree;
+    tree.put("type", static_cast<int>(
+        RemoteMessage::MessageType::kRecordingStopResponse));
+    tree.put("error", error);
+
+    boost::property_tree::write_json(msg, tree, false);
+  }
+
+  websocketpp::lib::error_code ec;
+  server_.send(connection, msg.str(), websocketpp::frame::opcode::text, ec);
+  if (ec) {
+    LogError(ec.message());
+    return false;
+  }
+
+  return true;
+}
+
+
 bool RemoteServer::RespondSettingsWebcamSearch(
     int request_key,
     const std::string &error,
@@ -1494,6 +2209,45 @@ void RemoteServer::BroadcastStreamingStop(
 }
 
 
+void RemoteServer::NotifyStreamingSimulcastStart(const std::string &id) {
+  boost::property_tree::ptree tree;
+  tree.put("type", static_cast<int>(
+      RemoteMessage::MessageType::kStreamingSimulcastStartEvent));
+  tree.put("id", id);
+  PostBroadcast(tree);
+}
+
+
+void RemoteServer::NotifyStreamingSimulcastStop(
+    const std::string &id,
+    ObsOutput::StopReason reason) {
+  static const std::unordered_map<ObsOutput::StopReason, std::string>
+      kReasons{{ObsOutput::StopReason::kUser, "user"},
+               {ObsOutput::StopReason::kNetwork, "network"},
+               {ObsOutput::StopReason::kTimeout, "timeout"},
+               {ObsOutput::StopReason::kRemote, "remote"}};
+
+  boost::property_tree::ptree tree;
+  tree.put("type", static_cast<int>(
+      RemoteMessage::MessageType::kStreamingSimulcastStopEvent));
+  tree.put("id", id);
+  tree.put("reason", kReasons.at(reason));
+  PostBroadcast(tree);
+}
+
+
+void RemoteServer::PostBroadcast(const boost::property_tree::ptree &tree) {
+  std::stringstream msg;
+  boost::property_tree::write_json(msg, tree, false);
+
+  // connections_ belongs to the server thread.
+  const std::string &msg_str = msg.str();
+  io_service_.post([this, msg_str]() {
+    Broadcast(msg_str);
+  });
+}
+
+
 void RemoteServer::Broadcast(const std::string &msg) {
   for (const auto &connection : connections_) {
     websocketpp::lib::error_code ec;
@@ -76,6 +76,16 @@ class RemoteServer {
       int request_key,
       const std::string &error);
 
+  // may be called from any thread.
+  void NotifyStreamingReconnect(
+      int attempt,
+      int64_t delay_ms,
+      const std::string &stream_server);
+
+  void NotifyStreamingRecovered(
+      int attempts,
+      const std::string &stream_server);
+
  private:
   class ConnectionHasher {
    public:
@@ -128,10 +138,26 @@ class RemoteServer {
       const websocketpp::connection_hdl &connection,
       const boost::property_tree::ptree &tree);
 
+  void OnStreamingSimulcastAddRequest(
+      const websocketpp::connection_hdl &connection,
+      const boost::property_tree::ptree &tree);
+
+  void OnStreamingSimulcastRemoveRequest(
+      const websocketpp::connection_hdl &connection,
+      const boost::property_tree::ptree &tree);
+
   void OnSettingsQualityUpdateRequest(
       const websocketpp::connection_hdl &connection,
       const boost::property_tree::ptree &tree);
 
+  void OnSettingsStreamDelayRequest(
+      const websocketpp::connection_hdl &connection,
+      const boost::property_tree::ptree &tree);
+
+  void OnSettingsCropRequest(
+      const websocketpp::connection_hdl &connection,
+      const boost::property_tree::ptree &tree);
+
   void OnCommentsRequest(
       const websocketpp::connection_hdl &connection,
       const boost::property_tree::ptree &tree);
@@ -140,6 +166,34 @@ class RemoteServer {
       const websocketpp::connection_hdl &connection,
       const boost::property_tree::ptree &tree);
 
+  void OnStatsRequest(
+      const websocketpp::connection_hdl &connection,
+      const boost::property_tree::ptree &tree);
+
+  void OnScenesRequest(
+      const websocketpp::connection_hdl &connection,
+      const boost::property_tree::ptree &tree);
+
+  void OnSceneSwitchRequest(
+      const websocketpp::connection_hdl &connection,
+      const boost::property_tree::ptree &tree);
+
+  void OnSceneBrbUpdateRequest(
+      const websocketpp::connection_hdl &connection,
+      const boost::property_tree::ptree &tree);
+
+  void OnRecordingStartRequest(
+      const websocketpp::connection_hdl &connection,
+      const boost::property_tree::ptree &tree);
+
+  void OnRecordingSaveRequest(
+      const websocketpp::connection_hdl &connection,
+      const boost::property_tree::ptree &tree);
+
+  void OnRecordingStopRequest(
+      const websocketpp::connection_hdl &connection,
+      const boost::property_tree::ptree &tree);
+
   void OnSettingsWebcamSearchRequest(
       const websocketpp::connection_hdl &connection,
       const boost::property_tree::ptree &tree);
@@ -204,10 +258,62 @@ class RemoteServer {
       int request_key,
       const std::string &error);
 
+  bool RespondStreamingSimulcastAdd(
+      int request_key,
+      const std::string &error,
+      const std::string &id);
+
+  bool RespondStreamingSimulcastRemove(
+      int request_key,
+      const std::string &error,
+      const std::string &id);
+
   bool RespondSettingsQualityUpdate(
       int request_key,
       const std::string &error);
 
+  bool RespondSettingsStreamDelay(
+      int request_key,
+      const std::string &error,
+      uint32_t delay,
+      uint64_t buffer_size);
+
+  bool RespondSettingsCrop(
+      int request_key,
+      const std::string &error);
+
+  bool RespondStreamingStats(
+      int request_key,
+      const std::string &error,
+      const std::vector<ObsStatsSampler::Sample> &samples);
+
+  bool RespondScenes(
+      int request_key,
+      const std::string &error,
+      const std::vector<std::string> &scenes,
+      const std::string &current);
+
+  bool RespondSceneSwitch(
+      int request_key,
+      const std::string &error,
+      const std::string &current);
+
+  bool RespondSceneBrbUpdate(
+      int request_key,
+      const std::string &error);
+
+  bool RespondRecordingStart(
+      int request_key,
+      const std::string &error);
+
+  bool RespondRecordingSave(
+      int request_key,
+      const std::string &error);
+
+  bool RespondRecordingStop(
+      int request_key,
+      const std::string &error);
+
   bool RespondSettingsWebcamSearch(
       int request_key,
       const std::string &error,
@@ -278,6 +384,14 @@ class RemoteServer {
   void BroadcastStreamingStop(
       const std::string &source);
 
+  // may be called from any thread.
+  void NotifyStreamingSimulcastStart(const std::string &id);
+  void NotifyStreamingSimulcastStop(
+      const std::string &id,
+      ObsOutput::StopReason reason);
+
+  void PostBroadcast(const boost::property_tree::ptree &tree);
+
   void Broadcast(const std::string &msg);
 
   void LogError(const std::string &err_msg);
@@ -0,0 +1,128 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/start_latency_recorder.h"
+
+#include <cassert>
+
+#include "boost/property_tree/json_parser.hpp"
+#include "boost/property_tree/ptree.hpp"
+
+
+namespace ncstreamer {
+void StartLatencyRecorder::SetUp(const std::wstring &log_path) {
+  assert(!static_instance);
+  static_instance = new StartLatencyRecorder{log_path};
+}
+
+
+void StartLatencyRecorder::ShutDown() {
+  assert(static_instance);
+  delete static_instance;
+  static_instance = nullptr;
+}
+
+
+StartLatencyRecorder *StartLatencyRecorder::Get() {
+  assert(static_instance);
+  return static_instance;
+}
+
+
+void StartLatencyRecorder::Begin() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  running_ = true;
+  begin_ = Clock::now();
+  marks_.clear();
+}
+
+
+void StartLatencyRecorder::Mark(Stage stage) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (running_ == false) {
+    return;
+  }
+  marks_.emplace_back(stage, Clock::now());
+}
+
+
+void StartLatencyRecorder::Finish(const std::string &error) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (running_ == false) {
+    return;
+  }
+  running_ = false;
+
+  if (log_file_.is_open() == false) {
+    return;
+  }
+
+  boost::property_tree::ptree tree_stages;
+  Clock::time_point last{begin_};
+  for (const auto &mark : marks_) {
+    boost::property_tree::ptree tree;
+    tree.put("stage", ToString(mark.first));
+    tree.put("ms", std::chrono::duration_cast<std::chrono::milliseconds>(
+        mark.second - last).count());
+    tree_stages.push_back({"", tree});
+    last = mark.second;
+  }
+
+  boost::property_tree::ptree tree;
+  tree.put("time", std::chrono::duration_cast<std::chrono::seconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count());
+  tree.put("error", error);
+  tree.put("totalMs", std::chrono::duration_cast<std::chrono::milliseconds>(
+      last - begin_).count());
+  tree.add_child("stages", tree_stages);
+
+  boost::property_tree::write_json(log_file_, tree, false);
+  log_file_.flush();
+}
+
+
+StartLatencyRecorder::StartLatencyRecorder(const std::wstring &log_path)
+    : log_file_{},
+      mutex_{},
+      running_{false},
+      begin_{},
+      marks_{} {
+  if (log_path.empty() == false) {
+    log_file_.open(log_path, std::ios::out | std::ios::app);
+  }
+}
+
+
+StartLatencyRecorder::~StartLatencyRecorder() {
+}
+
+
+const char *StartLatencyRecorder::ToString(Stage stage) {
+  switch (stage) {
+  case Stage::kLiveVideoPosted:
+    return "liveVideoPosted";
+  case Stage::kMockPosted:
+    return "mockPost";
+  case Stage::kSourceUpdated:
+    return "sourceUpdated";
+  case Stage::kBaseResolutionUpdated:
+    return "baseResolutionUpdated";
+  case Stage::kVideoReset:
+    return "videoReset";
+  case Stage::kServiceUpdated:
+    return "serviceUpdated";
+  case Stage::kOutputStarting:
+    return "outputStarting";
+  case Stage::kOutputStarted:
+    return "outputStarted";
+  default:
+    break;
+  }
+  return "unknown";
+}
+
+
+StartLatencyRecorder *StartLatencyRecorder::static_instance{nullptr};
+}  // namespace ncstreamer
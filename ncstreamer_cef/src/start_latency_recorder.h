@@ -0,0 +1,62 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_START_LATENCY_RECORDER_H_
+#define NCSTREAMER_CEF_SRC_START_LATENCY_RECORDER_H_
+
+
+#include <chrono>  // NOLINT
+#include <fstream>
+#include <mutex>  // NOLINT
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace ncstreamer {
+// Times each stage from the streaming start command to the output's start
+// signal and appends one JSON line per start to the log file, if any.
+class StartLatencyRecorder {
+ public:
+  enum class Stage {
+    kLiveVideoPosted,
+    kMockPosted,  // start_latency_bench's stand-in for kLiveVideoPosted.
+    kSourceUpdated,
+    kBaseResolutionUpdated,
+    kVideoReset,
+    kServiceUpdated,
+    kOutputStarting,
+    kOutputStarted,
+  };
+
+  static void SetUp(const std::wstring &log_path);
+  static void ShutDown();
+  static StartLatencyRecorder *Get();
+
+  void Begin();
+  void Mark(Stage stage);
+  void Finish(const std::string &error);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  explicit StartLatencyRecorder(const std::wstring &log_path);
+  virtual ~StartLatencyRecorder();
+
+  static const char *ToString(Stage stage);
+
+  static StartLatencyRecorder *static_instance;
+
+  std::ofstream log_file_;
+
+  std::mutex mutex_;
+  bool running_;
+  Clock::time_point begin_;
+  std::vector<std::pair<Stage, Clock::time_point>> marks_;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_START_LATENCY_RECORDER_H_
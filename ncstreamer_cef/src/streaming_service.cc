@@ -5,7 +5,9 @@
 
 #include "ncstreamer_cef/src/streaming_service.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>  // NOLINT
 
 #include "ncstreamer_cef/src/streaming_service/facebook.h"
 #include "ncstreamer_cef/src/streaming_service/twitch.h"
@@ -41,7 +43,10 @@ StreamingService::StreamingService(
           {"Twitch", std::shared_ptr<Twitch>{new Twitch{}}},
           {"YouTube", std::shared_ptr<YouTube>{new YouTube{}}}},
       current_service_provider_id_{nullptr},
-      current_service_provider_{} {
+      current_service_provider_{},
+      stream_servers_mutex_{},
+      stream_server_urls_{},
+      ingest_prober_{std::chrono::minutes{10}, std::chrono::seconds{3}} {
 }
 
 
@@ -66,13 +71,37 @@ void StreamingService::LogIn(
   current_service_provider_id_ = &(i->first);
   current_service_provider_ = i->second;
 
+  {
+    std::lock_guard<std::mutex> lock{stream_servers_mutex_};
+    stream_server_urls_.clear();
+  }
+
   current_service_provider_->LogIn(
       parent,
       locale,
       [this, on_failed](const std::string &error) {
         HandleFail(on_failed, kFunc, error);
       },
-      on_logged_in);
+      [this, on_logged_in](
+          const std::string &id,
+          const std::string &access_token,
+          const std::string &user_name,
+          const std::vector<StreamingServiceProvider::UserPage> &user_pages,
+          const std::vector<
+              StreamingServiceProvider::StreamServer> &stream_servers) {
+        std::vector<std::string> urls;
+        for (const auto &server : stream_servers) {
+          urls.emplace_back(server.url());
+        }
+        {
+          std::lock_guard<std::mutex> lock{stream_servers_mutex_};
+          stream_server_urls_ = urls;
+        }
+        // warms up the ranking for kAutoStreamServer.
+        ingest_prober_.Rank(urls, [](
+            const std::vector<IngestProber::Result> &/*ranking*/) {});
+        on_logged_in(id, access_token, user_name, user_pages, stream_servers);
+      });
 }
 
 
@@ -118,28 +147,45 @@ void StreamingService::PostLiveVideo(
 
   const std::string &service_provider_id = *current_service_provider_id_;
   const std::string &tag_id = FindTagId(service_provider_id, source);
+  std::shared_ptr<StreamingServiceProvider> service_provider =
+      current_service_provider_;
 
-  current_service_provider_->PostLiveVideo(
-      stream_server,
-      user_page_id,
-      privacy,
-      title,
-      description,
-      tag_id,
+  ResolveStreamServer(stream_server,
       [this, on_failed](const std::string &error) {
         HandleFail(on_failed, kFunc, error);
-      },
-      [on_live_video_posted, service_provider_id](
-          const std::string &stream_server,
-          const std::string &stream_key,
-          const std::string &video_id,
-          const std::string &post_url) {
-        on_live_video_posted(service_provider_id,
-                             stream_server,
-                             stream_key,
-                             video_id,
-                             post_url);
-      });
+      }, [this,
+          service_provider,
+          service_provider_id,
+          user_page_id,
+          privacy,
+          title,
+          description,
+          tag_id,
+          on_failed,
+          on_live_video_posted](
+      const std::string &resolved_server) {
+    service_provider->PostLiveVideo(
+        resolved_server,
+        user_page_id,
+        privacy,
+        title,
+        description,
+        tag_id,
+        [this, on_failed](const std::string &error) {
+          HandleFail(on_failed, kFunc, error);
+        },
+        [on_live_video_posted, service_provider_id](
+            const std::string &stream_server,
+            const std::string &stream_key,
+            const std::string &video_id,
+            const std::string &post_url) {
+          on_live_video_posted(service_provider_id,
+                               stream_server,
+                               stream_key,
+                               video_id,
+                               post_url);
+        });
+  });
 }
 
 
@@ -196,6 +242,38 @@ void StreamingService::LogOutAll() {
 }
 
 
+std::vector<std::string> StreamingService::GetFallbackServers(
+    const std::string &stream_server) const {
+  std::lock_guard<std::mutex> lock{stream_servers_mutex_};
+  std::vector<std::string> fallback_servers;
+  bool offered{false};
+  for (const auto &url : stream_server_urls_) {
+    if (url == stream_server) {
+      offered = true;
+    } else {
+      fallback_servers.emplace_back(url);
+    }
+  }
+  if (offered == false) {
+    fallback_servers.clear();
+  }
+
+  const auto &ranking = ingest_prober_.GetCachedRanking(stream_server_urls_);
+  auto rank_of = [&ranking](const std::string &url) {
+    auto i = std::find_if(ranking.begin(), ranking.end(),
+        [&url](const IngestProber::Result &result) {
+      return result.url == url;
+    });
+    return i - ranking.begin();
+  };
+  std::stable_sort(fallback_servers.begin(), fallback_servers.end(),
+      [&rank_of](const std::string &left, const std::string &right) {
+    return rank_of(left) < rank_of(right);
+  });
+  return fallback_servers;
+}
+
+
 std::string StreamingService::FailMessage::ToUnknownServiceProvider(
     const std::string &service_provider_id) {
   std::stringstream msg;
@@ -211,6 +289,13 @@ std::string StreamingService::FailMessage::ToNotLoggedIn() {
 }
 
 
+std::string StreamingService::FailMessage::ToNoReachableStreamServer() {
+  std::stringstream msg;
+  msg << "no reachable stream server";
+  return msg.str();
+}
+
+
 const std::string &StreamingService::FindTagId(
     const std::string &service_provider,
     const std::string &source) const {
@@ -244,5 +329,34 @@ void StreamingService::HandleFail(
 }
 
 
+void StreamingService::ResolveStreamServer(
+    const std::string &stream_server,
+    const OnFailed &on_failed,
+    const OnStreamServerResolved &on_resolved) {
+  if (stream_server != kAutoStreamServer) {
+    on_resolved(stream_server);
+    return;
+  }
+
+  std::vector<std::string> urls;
+  {
+    std::lock_guard<std::mutex> lock{stream_servers_mutex_};
+    urls = stream_server_urls_;
+  }
+  ingest_prober_.Rank(urls, [on_failed, on_resolved](
+      const std::vector<IngestProber::Result> &ranking) {
+    // the fastest is unreachable only if every server is.
+    if (ranking.empty() == true || ranking.front().connect_ms < 0) {
+      on_failed(FailMessage::ToNoReachableStreamServer());
+      return;
+    }
+    on_resolved(ranking.front().url);
+  });
+}
+
+
+const char *StreamingService::kAutoStreamServer{"auto"};
+
+
 StreamingService *StreamingService::static_instance{nullptr};
 }  // namespace ncstreamer
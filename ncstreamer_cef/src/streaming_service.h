@@ -8,12 +8,15 @@
 
 
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "boost/optional.hpp"
 #include "windows.h"  // NOLINT
 
+#include "ncstreamer_cef/src/streaming_service/ingest_prober.h"
 #include "ncstreamer_cef/src/streaming_service/streaming_service_provider.h"
 #include "ncstreamer_cef/src/streaming_service/streaming_service_types.h"
 
@@ -35,6 +38,9 @@ class StreamingService {
   using OnLiveVideoViewers =
       std::function<void(const std::string &viewers)>;
 
+  // stands for the fastest of the provider's ingest servers.
+  static const char *kAutoStreamServer;
+
   static void SetUp(
       const StreamingServiceTagMap &tag_ids);
 
@@ -76,12 +82,18 @@ class StreamingService {
 
   void LogOutAll();
 
+  // the other ingest servers the current provider offered at log in,
+  // fastest first once they have been probed.
+  std::vector<std::string> GetFallbackServers(
+      const std::string &stream_server) const;
+
  private:
   class FailMessage {
    public:
     static std::string ToUnknownServiceProvider(
         const std::string &service_provider_id);
     static std::string ToNotLoggedIn();
+    static std::string ToNoReachableStreamServer();
   };
 
   explicit StreamingService(
@@ -98,6 +110,15 @@ class StreamingService {
       const std::string &func,
       const std::string &msg);
 
+  using OnStreamServerResolved =
+      std::function<void(const std::string &stream_server)>;
+
+  // fails when "auto" finds no reachable server.
+  void ResolveStreamServer(
+      const std::string &stream_server,
+      const OnFailed &on_failed,
+      const OnStreamServerResolved &on_resolved);
+
   static StreamingService *static_instance;
 
   const StreamingServiceTagMap tag_ids_;
@@ -108,6 +129,10 @@ class StreamingService {
 
   const std::string *current_service_provider_id_;
   std::shared_ptr<StreamingServiceProvider> current_service_provider_;
+
+  mutable std::mutex stream_servers_mutex_;
+  std::vector<std::string> stream_server_urls_;
+  IngestProber ingest_prober_;
 };
 }  // namespace ncstreamer
 
@@ -0,0 +1,312 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#include "ncstreamer_cef/src/streaming_service/ingest_prober.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+
+#include "boost/asio/connect.hpp"
+#include "boost/asio/deadline_timer.hpp"
+#include "boost/asio/ip/tcp.hpp"
+#include "boost/asio/read.hpp"
+#include "boost/asio/write.hpp"
+
+
+namespace ncstreamer {
+class IngestProber::Round {
+ public:
+  using OnCompleted = std::function<void(std::vector<Result> *results)>;
+
+  Round(std::size_t size, const OnCompleted &on_completed)
+      : results_(size),
+        pending_{size},
+        on_completed_{on_completed} {
+  }
+
+  // called on the prober thread only.
+  void Report(std::size_t index, const Result &result) {
+    results_[index] = result;
+    if (--pending_ == 0) {
+      on_completed_(&results_);
+    }
+  }
+
+ private:
+  std::vector<Result> results_;
+  std::size_t pending_;
+  OnCompleted on_completed_;
+};
+
+
+class IngestProber::Probe
+    : public std::enable_shared_from_this<IngestProber::Probe> {
+ public:
+  Probe(
+      boost::asio::io_service *svc,
+      const std::shared_ptr<Round> &round,
+      std::size_t index,
+      const std::string &url)
+      : round_{round},
+        index_{index},
+        result_{},
+        resolver_{*svc},
+        socket_{*svc},
+        timer_{*svc},
+        start_time_{},
+        c0c1_{},
+        s0s1_{},
+        completed_{false} {
+    result_.url = url;
+  }
+
+  void Start(const std::chrono::milliseconds &timeout) {
+    std::string host;
+    std::string port;
+    if (ParseEndpoint(result_.url, &host, &port) == false) {
+      Complete();
+      return;
+    }
+
+    auto self = shared_from_this();
+    timer_.expires_from_now(
+        boost::posix_time::milliseconds{timeout.count()});
+    timer_.async_wait([self](const boost::system::error_code &ec) {
+      if (ec != boost::asio::error::operation_aborted) {
+        self->Complete();
+      }
+    });
+
+    resolver_.async_resolve(
+        boost::asio::ip::tcp::resolver::query{host, port}, [self](
+        const boost::system::error_code &ec,
+        boost::asio::ip::tcp::resolver::iterator endpoints) {
+      if (ec) {
+        self->Complete();
+        return;
+      }
+      self->Connect(endpoints);
+    });
+  }
+
+ private:
+  static const std::size_t kHandshakeSize{1 + 1536};
+  static const char kRtmpVersion{3};
+
+  void Connect(boost::asio::ip::tcp::resolver::iterator endpoints) {
+    auto self = shared_from_this();
+    start_time_ = std::chrono::steady_clock::now();
+    boost::asio::async_connect(socket_, endpoints, [self](
+        const boost::system::error_code &ec,
+        boost::asio::ip::tcp::resolver::iterator /*endpoint*/) {
+      if (ec) {
+        self->Complete();
+        return;
+      }
+      self->result_.connect_ms = self->GetElapsedMs();
+      self->Handshake();
+    });
+  }
+
+  void Handshake() {
+    auto self = shared_from_this();
+    c0c1_.fill(0);
+    c0c1_[0] = kRtmpVersion;
+    start_time_ = std::chrono::steady_clock::now();
+    boost::asio::async_write(socket_, boost::asio::buffer(c0c1_), [self](
+        const boost::system::error_code &ec, std::size_t /*length*/) {
+      if (ec) {
+        self->Complete();
+        return;
+      }
+      boost::asio::async_read(self->socket_,
+          boost::asio::buffer(self->s0s1_), [self](
+              const boost::system::error_code &read_ec,
+              std::size_t /*length*/) {
+        if (!read_ec && self->s0s1_[0] == kRtmpVersion) {
+          self->result_.handshake_ms = self->GetElapsedMs();
+        }
+        self->Complete();
+      });
+    });
+  }
+
+  void Complete() {
+    if (completed_ == true) {
+      return;
+    }
+    completed_ = true;
+
+    boost::system::error_code ec;
+    timer_.cancel(ec);
+    resolver_.cancel();
+    socket_.close(ec);
+    round_->Report(index_, result_);
+  }
+
+  int64_t GetElapsedMs() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start_time_).count();
+  }
+
+  const std::shared_ptr<Round> round_;
+  const std::size_t index_;
+  Result result_;
+
+  boost::asio::ip::tcp::resolver resolver_;
+  boost::asio::ip::tcp::socket socket_;
+  boost::asio::deadline_timer timer_;
+  std::chrono::steady_clock::time_point start_time_;
+
+  std::array<char, kHandshakeSize> c0c1_;
+  std::array<char, kHandshakeSize> s0s1_;
+  bool completed_;
+};
+
+
+IngestProber::Result::Result()
+    : url{},
+      connect_ms{-1},
+      handshake_ms{-1} {
+}
+
+
+IngestProber::IngestProber(
+    const std::chrono::seconds &ttl,
+    const std::chrono::milliseconds &timeout)
+    : ttl_{ttl},
+      timeout_{timeout},
+      io_service_{},
+      io_service_work_{io_service_},
+      io_thread_{[this]() {
+        io_service_.run();
+      }},
+      cache_mutex_{},
+      cache_key_{},
+      cache_{},
+      cache_time_{} {
+}
+
+
+IngestProber::~IngestProber() {
+  io_service_.stop();
+  if (io_thread_.joinable() == true) {
+    io_thread_.join();
+  }
+}
+
+
+void IngestProber::Rank(
+    const std::vector<std::string> &urls,
+    const OnRanked &on_ranked) {
+  const std::string &cache_key = ToCacheKey(urls);
+  const std::vector<Result> &cached = GetCachedRanking(urls);
+  if (urls.empty() == true || cached.empty() == false) {
+    io_service_.post([cached, on_ranked]() {
+      on_ranked(cached);
+    });
+    return;
+  }
+
+  auto round = std::make_shared<Round>(urls.size(),
+      [this, cache_key, on_ranked](std::vector<Result> *results) {
+    OnRoundCompleted(cache_key, results, on_ranked);
+  });
+  const std::chrono::milliseconds timeout = timeout_;
+  for (std::size_t i = 0; i < urls.size(); ++i) {
+    auto probe = std::make_shared<Probe>(&io_service_, round, i, urls[i]);
+    io_service_.post([probe, timeout]() {
+      probe->Start(timeout);
+    });
+  }
+}
+
+
+std::vector<IngestProber::Result> IngestProber::GetCachedRanking(
+    const std::vector<std::string> &urls) const {
+  std::lock_guard<std::mutex> lock{cache_mutex_};
+  if (cache_key_ != ToCacheKey(urls) ||
+      std::chrono::steady_clock::now() - cache_time_ >= ttl_) {
+    return {};
+  }
+  return cache_;
+}
+
+
+std::string IngestProber::ToCacheKey(const std::vector<std::string> &urls) {
+  std::vector<std::string> sorted{urls};
+  std::sort(sorted.begin(), sorted.end());
+
+  std::string key;
+  for (const auto &url : sorted) {
+    key += url + "\n";
+  }
+  return key;
+}
+
+
+bool IngestProber::ParseEndpoint(
+    const std::string &url,
+    std::string *host,
+    std::string *port) {
+  static const std::string kSchemeSeparator{"://"};
+  static const std::string kDefaultPort{"1935"};
+
+  const std::size_t scheme_end = url.find(kSchemeSeparator);
+  const std::size_t host_begin = (scheme_end == std::string::npos) ?
+      0 : scheme_end + kSchemeSeparator.size();
+  const std::size_t host_end = url.find_first_of(":/", host_begin);
+  *host = url.substr(host_begin, host_end - host_begin);
+  if (host->empty() == true) {
+    return false;
+  }
+
+  *port = kDefaultPort;
+  if (host_end != std::string::npos && url[host_end] == ':') {
+    const std::size_t port_end = url.find('/', host_end);
+    *port = url.substr(host_end + 1, port_end - host_end - 1);
+  }
+  return port->empty() == false;
+}
+
+
+bool IngestProber::IsFaster(const Result &left, const Result &right) {
+  // a full handshake beats a bare connect, which beats no answer.
+  const bool left_handshakes = (left.handshake_ms >= 0);
+  const bool right_handshakes = (right.handshake_ms >= 0);
+  if (left_handshakes != right_handshakes) {
+    return left_handshakes;
+  }
+  if (left_handshakes == true) {
+    return left.connect_ms + left.handshake_ms <
+           right.connect_ms + right.handshake_ms;
+  }
+
+  const bool left_connects = (left.connect_ms >= 0);
+  const bool right_connects = (right.connect_ms >= 0);
+  if (left_connects != right_connects) {
+    return left_connects;
+  }
+  return left.connect_ms < right.connect_ms;
+}
+
+
+void IngestProber::OnRoundCompleted(
+    const std::string &cache_key,
+    std::vector<Result> *results,
+    const OnRanked &on_ranked) {
+  std::stable_sort(results->begin(), results->end(), IsFaster);
+  // a round where nothing connected says more about the network than
+  // about the servers, so the next start probes again.
+  if (results->empty() == false && results->front().connect_ms >= 0) {
+    std::lock_guard<std::mutex> lock{cache_mutex_};
+    cache_key_ = cache_key;
+    cache_ = *results;
+    cache_time_ = std::chrono::steady_clock::now();
+  }
+  on_ranked(*results);
+}
+}  // namespace ncstreamer
@@ -0,0 +1,81 @@
+/**
+ * Copyright (C) 2017 NCSOFT Corporation
+ */
+
+
+#ifndef NCSTREAMER_CEF_SRC_STREAMING_SERVICE_INGEST_PROBER_H_
+#define NCSTREAMER_CEF_SRC_STREAMING_SERVICE_INGEST_PROBER_H_
+
+
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <functional>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "boost/asio/io_service.hpp"
+
+
+namespace ncstreamer {
+// Measures the TCP connect and RTMP handshake (C0+C1 -> S0+S1) round trip
+// to each ingest server in parallel and ranks them fastest first.
+class IngestProber {
+ public:
+  class Result {
+   public:
+    Result();
+
+    std::string url;
+    int64_t connect_ms;  // -1 if unreachable.
+    int64_t handshake_ms;  // -1 if the server did not answer the handshake.
+  };
+
+  using OnRanked = std::function<void(const std::vector<Result> &ranking)>;
+
+  IngestProber(
+      const std::chrono::seconds &ttl,
+      const std::chrono::milliseconds &timeout);
+  virtual ~IngestProber();
+
+  // answers from the cache when the same urls were ranked within the ttl.
+  // on_ranked is called on the prober thread.
+  void Rank(
+      const std::vector<std::string> &urls,
+      const OnRanked &on_ranked);
+  std::vector<Result> GetCachedRanking(
+      const std::vector<std::string> &urls) const;
+
+ private:
+  class Probe;
+  class Round;
+
+  static std::string ToCacheKey(const std::vector<std::string> &urls);
+  static bool ParseEndpoint(
+      const std::string &url,
+      std::string *host,
+      std::string *port);
+  static bool IsFaster(const Result &left, const Result &right);
+
+  void OnRoundCompleted(
+      const std::string &cache_key,
+      std::vector<Result> *results,
+      const OnRanked &on_ranked);
+
+  const std::chrono::seconds ttl_;
+  const std::chrono::milliseconds timeout_;
+
+  boost::asio::io_service io_service_;
+  boost::asio::io_service::work io_service_work_;
+  std::thread io_thread_;
+
+  mutable std::mutex cache_mutex_;
+  std::string cache_key_;
+  std::vector<Result> cache_;
+  std::chrono::steady_clock::time_point cache_time_;
+};
+}  // namespace ncstreamer
+
+
+#endif  // NCSTREAMER_CEF_SRC_STREAMING_SERVICE_INGEST_PROBER_H_
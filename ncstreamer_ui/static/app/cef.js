@@ -42,12 +42,20 @@ const cef = (function() {
     },
     'streaming/stop': {
       request: [],
-      response: ['error'],
+      response: ['error', 'reason'],
+    },
+    'streaming/stats': {
+      request: ['count'],
+      response: ['error', 'stats'],
     },
     'settings/video_quality/update': {
       request: ['width', 'height', 'fps', 'bitrate'],
       response: ['error'],
     },
+    'settings/stream_delay/update': {
+      request: ['delay'],
+      response: ['error', 'delay', 'bufferSize'],
+    },
     'settings/mic/search': {
       request: [],
       response: ['error', 'micList'],
@@ -64,6 +72,22 @@ const cef = (function() {
       request: ['volume'],
       response: ['error', 'volume'],
     },
+    'settings/desktop/volume/update': {
+      request: ['volume'],
+      response: ['error', 'volume'],
+    },
+    'settings/mic/filters/update': {
+      request: ['noiseGate', 'noiseSuppression'],
+      response: ['error'],
+    },
+    'settings/audio/format/update': {
+      request: ['sampleRate', 'channels'],
+      response: ['error'],
+    },
+    'settings/audio/quality/update': {
+      request: ['bitrate'],
+      response: ['error'],
+    },
     'settings/webcam/search': {
       request: [],
       response: ['error', 'webcamList'],
@@ -311,6 +335,10 @@ const remote = {
   onSettingsChromaKeySimilarityRequest: function(args) {
     app.streaming.webcam.chromaKey.similarity = args.similarity;
   },
+  onSettingsStreamDelayRequest: function(args) {
+    app.streaming.delay = args.delay;
+    setStreamDelaySelect(args.delay);
+  },
   onSettingsMicOnRequest: function(args) {
     app.streaming.mic.curDeviceId = args.deviceId;
     app.dom.micCheckbox.checked = true;
@@ -42,12 +42,12 @@ ncsoft.onDOMContentLoaded = function() {
   $(document).on('click', '.form-checkbox.mic #mic-checkbox', function() {
     adjustRange(_range);
     if ($(this).is(':checked') !== true) {
-      $('.range-slider-range').attr(
+      $('.form-checkbox.mic .range-slider-range').attr(
           'value', _range.value).removeAttr(
           'style').attr('disabled', 'disabled');
     }
     else {
-      $('.range-slider-range').attr(
+      $('.form-checkbox.mic .range-slider-range').attr(
           'value', _range.value).removeAttr('disabled');
     }
   });
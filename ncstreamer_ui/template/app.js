@@ -28,6 +28,19 @@ const app = {
         value: 0.5,
       }
     },
+    delay: 0,  // seconds
+    audio: {
+      desktopVolume: {
+        max: 1,
+        min: 0,
+        step: 0.1,
+        value: 1,
+      },
+      noiseGate: true,
+      noiseSuppression: true,
+      quality: '160',
+      format: '48000/stereo',
+    },
     webcam: {
       use: false,
       list: null,
@@ -282,6 +295,12 @@ function setUpControls(args) {
     'live-image',
     'control-button',
     'quality-select',
+    'stream-delay-select',
+    'desktop-volume',
+    'mic-noise-gate-checkbox',
+    'mic-noise-suppression-checkbox',
+    'audio-quality-select',
+    'audio-format-select',
     'chroma-key-checkbox',
     'modal-close-button',
     'twitch-settings-popup',
@@ -334,6 +353,18 @@ function setUpControls(args) {
       'click', onControlButtonClicked);
   app.dom.qualitySelect.addEventListener(
       'ncsoftSelectChange', onQualitySelectChanged);
+  app.dom.streamDelaySelect.addEventListener(
+      'ncsoftSelectChange', onStreamDelaySelectChanged);
+  app.dom.desktopVolume.addEventListener(
+      'change', onDesktopVolumeChanged);
+  app.dom.micNoiseGateCheckbox.addEventListener(
+      'change', onMicFiltersCheckboxChanged);
+  app.dom.micNoiseSuppressionCheckbox.addEventListener(
+      'change', onMicFiltersCheckboxChanged);
+  app.dom.audioQualitySelect.addEventListener(
+      'ncsoftSelectChange', onAudioQualitySelectChanged);
+  app.dom.audioFormatSelect.addEventListener(
+      'ncsoftSelectChange', onAudioFormatSelectChanged);
   app.dom.chromaKeyCheckbox.addEventListener(
       'change', onchromaKeyCheckboxChanged);
   app.dom.modalCloseButton.addEventListener(
@@ -370,6 +401,8 @@ function setUpControls(args) {
   }
   setUpSteamingQuality();
   ncsoft.select.setByValue(app.dom.qualitySelect, args.videoQuality);
+  setStreamDelaySelect(app.streaming.delay);
+  setUpAudio();
   cef.streamingSetUp.request();
 }
 
@@ -762,6 +795,57 @@ function onQualitySelectChanged() {
 }
 
 
+function onStreamDelaySelectChanged() {
+  const delay = ncsoft.select.getValue(app.dom.streamDelaySelect);
+  console.info(JSON.stringify({ streamDelay: delay }));
+  cef.settingsStreamDelayUpdate.request(delay);
+}
+
+
+function setStreamDelaySelect(delay) {
+  // a delay shortened to fit the buffer is not one of the options.
+  if (ncsoft.select.setByValue(app.dom.streamDelaySelect, delay) == false) {
+    ncsoft.select.setText(app.dom.streamDelaySelect, delay + ' %SECONDS%');
+  }
+}
+
+
+function onDesktopVolumeChanged() {
+  console.info('change desktopVolume');
+  ncsoft.slider.adjustRange(app.dom.desktopVolume);
+  cef.settingsDesktopVolumeUpdate.request(app.dom.desktopVolume.value);
+}
+
+
+function onMicFiltersCheckboxChanged() {
+  const audio = app.streaming.audio;
+  audio.noiseGate = app.dom.micNoiseGateCheckbox.checked;
+  audio.noiseSuppression = app.dom.micNoiseSuppressionCheckbox.checked;
+  console.info(JSON.stringify({
+    noiseGate: audio.noiseGate,
+    noiseSuppression: audio.noiseSuppression,
+  }));
+  cef.settingsMicFiltersUpdate.request(
+      audio.noiseGate, audio.noiseSuppression);
+}
+
+
+function onAudioQualitySelectChanged() {
+  const bitrate = ncsoft.select.getValue(app.dom.audioQualitySelect);
+  console.info(JSON.stringify({ audioQuality: bitrate }));
+  cef.settingsAudioQualityUpdate.request(bitrate);
+}
+
+
+function onAudioFormatSelectChanged() {
+  const format = ncsoft.select.getValue(app.dom.audioFormatSelect);
+  console.info(JSON.stringify({ audioFormat: format }));
+  const sampleRateAndChannels = format.split('/');
+  cef.settingsAudioFormatUpdate.request(
+      sampleRateAndChannels[0], sampleRateAndChannels[1]);
+}
+
+
 function onchromaKeyCheckboxChanged() {
   if (app.dom.chromaKeyCheckbox.checked) {
     const color = app.streaming.webcam.chromaKey.color;
@@ -917,6 +1001,20 @@ function setUpMic(check) {
 }
 
 
+function setUpAudio() {
+  const audio = app.streaming.audio;
+  app.dom.desktopVolume.max = audio.desktopVolume.max;
+  app.dom.desktopVolume.min = audio.desktopVolume.min;
+  app.dom.desktopVolume.step = audio.desktopVolume.step;
+  app.dom.desktopVolume.value = audio.desktopVolume.value;
+  ncsoft.slider.adjustRange(app.dom.desktopVolume);
+  app.dom.micNoiseGateCheckbox.checked = audio.noiseGate;
+  app.dom.micNoiseSuppressionCheckbox.checked = audio.noiseSuppression;
+  ncsoft.select.setByValue(app.dom.audioQualitySelect, audio.quality);
+  ncsoft.select.setByValue(app.dom.audioFormatSelect, audio.format);
+}
+
+
 function setMicCheckBox(check) {
   app.dom.micCheckbox.checked = check;
   if (check == true) {
@@ -1370,7 +1468,59 @@ cef.settingsVideoQualityUpdate.onResponse = function(error) {
 };
 
 
+cef.settingsStreamDelayUpdate.onResponse = function(
+    error, delay, bufferSize) {
+  if (error != '') {
+    console.info(error);
+    setStreamDelaySelect(app.streaming.delay);
+    return;
+  }
+  console.info(JSON.stringify({ streamDelay: delay, bufferSize: bufferSize }));
+  app.streaming.delay = delay;
+  setStreamDelaySelect(delay);
+};
+
+
+cef.settingsDesktopVolumeUpdate.onResponse = function(error, volume) {
+  if (error != '') {
+    console.info(error);
+    return;
+  }
+  app.streaming.audio.desktopVolume.value = volume;
+};
+
+
+cef.settingsAudioQualityUpdate.onResponse = function(error) {
+  if (error != '') {
+    console.info(error);
+    ncsoft.select.setByValue(
+        app.dom.audioQualitySelect, app.streaming.audio.quality);
+    return;
+  }
+  app.streaming.audio.quality =
+      ncsoft.select.getValue(app.dom.audioQualitySelect);
+};
+
+
+cef.settingsAudioFormatUpdate.onResponse = function(error) {
+  if (error != '') {
+    // the format cannot change while streaming.
+    console.info(error);
+    ncsoft.select.setByValue(
+        app.dom.audioFormatSelect, app.streaming.audio.format);
+    return;
+  }
+  app.streaming.audio.format =
+      ncsoft.select.getValue(app.dom.audioFormatSelect);
+};
+
+
 cef.settingsMicSearch.onResponse = function(error, micList) {
+  if (error == 'not ready') {
+    // libobs is still starting up; ask again shortly.
+    setTimeout(cef.settingsMicSearch.request, 500);
+    return;
+  }
   if (error != '') {
     console.info(error);
     ncsoft.checkbox.enable(app.dom.micCheckbox);
@@ -1428,6 +1578,11 @@ cef.settingsMicVolumeUpdate.onResponse = function(error, volume) {
 
 
 cef.settingsWebcamSearch.onResponse = function(error, webcamList) {
+  if (error == 'not ready') {
+    // libobs is still starting up; ask again shortly.
+    setTimeout(cef.settingsWebcamSearch.request, 500);
+    return;
+  }
   if (error != '') {
     console.info(error);
     ncsoft.checkbox.enable(app.dom.webcamCheckbox);
@@ -0,0 +1,198 @@
+/**
+* Copyright (C) 2017 NCSOFT Corporation
+*/
+
+
+#include "session_journal_reader/src/journal_reader.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
+#include "boost/filesystem.hpp"
+#include "boost/property_tree/json_parser.hpp"
+
+
+namespace session_journal_reader {
+std::string Run(
+    const std::string &input,
+    bool prints_samples,
+    std::ostream *info_out) {
+  std::string err_msg{};
+
+  JournalFiles journals;
+  try {
+    journals = ListJournalFiles(input);
+  } catch (const std::exception &e) {
+    err_msg = e.what();
+  }
+  if (!err_msg.empty()) {
+    return err_msg;
+  }
+  if (journals.empty()) {
+    return "no journal files in " + input;
+  }
+
+  // session loop
+  for (const auto &journal : journals) {
+    const auto &records = ReadRecords(journal.second);
+    PrintSummary(journal.first, records, info_out);
+    if (prints_samples) {
+      PrintSamples(records, info_out);
+    }
+    *info_out << std::endl;
+  }
+  return err_msg;
+}
+
+
+JournalFiles ListJournalFiles(
+    const std::string &input) {
+  std::vector<boost::filesystem::path> paths;
+  boost::filesystem::path input_path{input};
+  if (boost::filesystem::exists(input_path) == false) {
+    return JournalFiles{};
+  }
+  if (boost::filesystem::is_directory(input_path)) {
+    for (const auto &entry :
+         boost::filesystem::directory_iterator{input_path}) {
+      if (entry.path().extension() == ".jsonl") {
+        paths.emplace_back(entry.path());
+      }
+    }
+  } else {
+    paths.emplace_back(input_path);
+  }
+  // "<session id>.<part>.jsonl" with zero-padded parts sorts in order.
+  std::sort(paths.begin(), paths.end());
+
+  JournalFiles journals;
+  for (const auto &path : paths) {
+    const std::string filename = path.filename().string();
+    const std::string &session_id = filename.substr(0, filename.find('.'));
+    journals[session_id].emplace_back(path);
+  }
+  return journals;
+}
+
+
+Records ReadRecords(
+    const std::vector<boost::filesystem::path> &parts) {
+  Records records;
+  for (const auto &part : parts) {
+    std::ifstream file{part.string()};
+    std::string line;
+    while (std::getline(file, line)) {
+      std::stringstream line_ss{line};
+      boost::property_tree::ptree record;
+      try {
+        boost::property_tree::read_json(line_ss, record);
+      } catch (const std::exception &/*e*/) {
+        continue;
+      }
+      records.emplace_back(record);
+    }
+  }
+  return records;
+}
+
+
+void PrintSummary(
+    const std::string &session_id,
+    const Records &records,
+    std::ostream *info_out) {
+  int64_t begin_time{0};
+  int64_t end_time{0};
+  std::size_t samples{0};
+  uint64_t bitrate_sum{0};
+  uint32_t bitrate_min{UINT32_MAX};
+  int dropped{0};
+  int output{0};
+  uint32_t lagged{0};
+  uint32_t skipped{0};
+  double frame_time_max{0.0};
+  double cpu_sum{0.0};
+  double cpu_max{0.0};
+  int reconnects{0};
+  int recoveries{0};
+  std::string stop_reason{"none (crashed or still live)"};
+
+  *info_out << "Session: " << session_id << std::endl;
+  for (const auto &record : records) {
+    const std::string &event = record.get("event", "");
+    const int64_t time = record.get<int64_t>("time", 0);
+    if (begin_time == 0) {
+      begin_time = time;
+    }
+    end_time = time;
+
+    if (event == "start") {
+      *info_out << "  Service: " << record.get("serviceProvider", "")
+                << " " << record.get("streamServer", "") << std::endl
+                << "  Output: " << record.get("outputWidth", "")
+                << "x" << record.get("outputHeight", "")
+                << "@" << record.get("fps", "")
+                << " " << record.get("videoEncoder", "")
+                << " " << record.get("videoBitrate", "") << "kbps"
+                << std::endl;
+    } else if (event == "sample") {
+      const uint32_t bitrate = record.get<uint32_t>("bitrate", 0);
+      const double cpu = record.get<double>("cpu", 0.0);
+      ++samples;
+      bitrate_sum += bitrate;
+      bitrate_min = std::min(bitrate_min, bitrate);
+      dropped = record.get<int>("dropped", dropped);
+      output = record.get<int>("output", output);
+      lagged = record.get<uint32_t>("lagged", lagged);
+      skipped = record.get<uint32_t>("skipped", skipped);
+      frame_time_max = std::max(
+          frame_time_max, record.get<double>("frameTimeMs", 0.0));
+      cpu_sum += cpu;
+      cpu_max = std::max(cpu_max, cpu);
+    } else if (event == "reconnect") {
+      ++reconnects;
+    } else if (event == "recovered") {
+      ++recoveries;
+    } else if (event == "stop") {
+      stop_reason = record.get("reason", "");
+    }
+  }
+
+  *info_out << "  Duration: " << (end_time - begin_time) << "s" << std::endl;
+  if (samples != 0) {
+    *info_out << "  Bitrate: avg " << (bitrate_sum / samples)
+              << "kbps, min " << bitrate_min << "kbps" << std::endl
+              << "  Frames: " << output << " sent, " << dropped
+              << " dropped, " << lagged << " lagged, " << skipped
+              << " skipped by the encoder" << std::endl
+              << "  Frame time: max " << frame_time_max << "ms" << std::endl
+              << "  CPU: avg " << (cpu_sum / samples)
+              << "%, max " << cpu_max << "%" << std::endl;
+  }
+  *info_out << "  Reconnects: " << reconnects
+            << " (" << recoveries << " recovered)" << std::endl
+            << "  Stop: " << stop_reason << std::endl;
+}
+
+
+void PrintSamples(
+    const Records &records,
+    std::ostream *info_out) {
+  *info_out << "time,bitrate,dropped,lagged,skipped,frameTimeMs,"
+               "congestion,cpu" << std::endl;
+  for (const auto &record : records) {
+    if (record.get("event", "") != "sample") {
+      continue;
+    }
+    *info_out << record.get("time", "") << ","
+              << record.get("bitrate", "") << ","
+              << record.get("dropped", "") << ","
+              << record.get("lagged", "") << ","
+              << record.get("skipped", "") << ","
+              << record.get("frameTimeMs", "") << ","
+              << record.get("congestion", "") << ","
+              << record.get("cpu", "") << std::endl;
+  }
+}
+}  // namespace session_journal_reader
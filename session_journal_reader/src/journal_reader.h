@@ -0,0 +1,48 @@
+/**
+* Copyright (C) 2017 NCSOFT Corporation
+*/
+
+
+#ifndef SESSION_JOURNAL_READER_SRC_JOURNAL_READER_H_
+#define SESSION_JOURNAL_READER_SRC_JOURNAL_READER_H_
+
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "boost/filesystem/path.hpp"
+#include "boost/property_tree/ptree.hpp"
+
+
+namespace session_journal_reader {
+using JournalFiles = std::map<
+    std::string /*session id*/, std::vector<boost::filesystem::path>>;
+using Records = std::vector<boost::property_tree::ptree>;
+
+extern std::string Run(
+    const std::string &input,
+    bool prints_samples,
+    std::ostream *info_out);
+
+// part files of each session, in order.
+extern JournalFiles ListJournalFiles(
+    const std::string &input);
+
+// skips lines that do not parse, e.g. one cut off by a crash.
+extern Records ReadRecords(
+    const std::vector<boost::filesystem::path> &parts);
+
+extern void PrintSummary(
+    const std::string &session_id,
+    const Records &records,
+    std::ostream *info_out);
+
+extern void PrintSamples(
+    const Records &records,
+    std::ostream *info_out);
+}  // namespace session_journal_reader
+
+
+#endif  // SESSION_JOURNAL_READER_SRC_JOURNAL_READER_H_
@@ -0,0 +1,33 @@
+/**
+* Copyright (C) 2017 NCSOFT Corporation
+*/
+
+
+#include <iostream>
+
+#include "session_journal_reader/src/journal_reader.h"
+#include "session_journal_reader/src/program_option_map.h"
+
+
+int main(int argc, char *argv[]) {
+  session_journal_reader::ProgramOptionMap options{argc, argv};
+  if (options.failed_to_parse()) {
+    std::cout << options.description();
+    return -1;
+  }
+  if (options.help()) {
+    std::cout << options.description();
+    return 0;
+  }
+
+  const std::string &err_msg = session_journal_reader::Run(
+      options.input(),
+      options.samples(),
+      &std::cout);
+  if (err_msg.empty() == false) {
+    std::cerr << err_msg << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,71 @@
+/**
+* Copyright (C) 2017 NCSOFT Corporation
+*/
+
+
+#include "session_journal_reader/src/program_option_map.h"
+
+
+namespace session_journal_reader {
+ProgramOptionMap::ProgramOptionMap(int argc, const char *const argv[])
+    : failed_to_parse_{false},
+      description_{"Options"},
+      help_{false},
+      input_{},
+      samples_{false} {
+  description_.add_options()
+      ("help", "Help screen")
+      ("input",
+        boost::program_options::value<std::string>()->default_value("./"),
+        "Journal file or directory of journal files")
+      ("samples", "Print the per-second samples as CSV");
+
+  boost::program_options::variables_map vm;
+  try {
+    boost::program_options::store(
+        parse_command_line(argc, argv, description_), vm);
+  } catch (const boost::program_options::error &/*e*/) {
+    failed_to_parse_ = true;
+  }
+
+  if (failed_to_parse_ == true) {
+    return;
+  }
+
+  boost::program_options::notify(vm);
+  help_ = (vm.count("help") >= 1);
+
+  input_ = vm["input"].as<std::string>();
+  samples_ = (vm.count("samples") >= 1);
+}
+
+
+bool ProgramOptionMap::failed_to_parse() const {
+  return failed_to_parse_;
+}
+
+
+const boost::program_options::options_description &
+    ProgramOptionMap::description() const {
+  return description_;
+}
+
+
+bool ProgramOptionMap::help() const {
+  return help_;
+}
+
+
+const std::string &ProgramOptionMap::input() const {
+  return input_;
+}
+
+
+bool ProgramOptionMap::samples() const {
+  return samples_;
+}
+
+
+ProgramOptionMap::~ProgramOptionMap() {
+}
+}  // namespace session_journal_reader
@@ -0,0 +1,38 @@
+/**
+* Copyright (C) 2017 NCSOFT Corporation
+*/
+
+
+#ifndef SESSION_JOURNAL_READER_SRC_PROGRAM_OPTION_MAP_H_
+#define SESSION_JOURNAL_READER_SRC_PROGRAM_OPTION_MAP_H_
+
+
+#include <string>
+#include "boost/program_options.hpp"
+
+
+namespace session_journal_reader {
+class ProgramOptionMap {
+ public:
+  ProgramOptionMap(int argc, const char *const argv[]);
+  virtual ~ProgramOptionMap();
+
+  bool failed_to_parse() const;
+  const boost::program_options::options_description &description() const;
+  bool help() const;
+
+  const std::string &input() const;
+  bool samples() const;
+
+ private:
+  bool failed_to_parse_;
+  boost::program_options::options_description description_;
+  bool help_;
+
+  std::string input_;
+  bool samples_;
+};
+}  // namespace session_journal_reader
+
+
+#endif  // SESSION_JOURNAL_READER_SRC_PROGRAM_OPTION_MAP_H_
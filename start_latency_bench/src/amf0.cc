@@ -0,0 +1,101 @@
+/**
+* Copyright (C) 2017 NCSOFT Corporation
+*/
+
+
+#include "start_latency_bench/src/amf0.h"
+
+#include <cstdint>
+#include <cstring>
+
+
+namespace start_latency_bench {
+void Amf0::WriteNumber(double value, std::string *out) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  out->push_back(static_cast<char>(Marker::kNumber));
+  for (int shift = 56; shift >= 0; shift -= 8) {
+    out->push_back(static_cast<char>((bits >> shift) & 0xFF));
+  }
+}
+
+
+void Amf0::WriteString(const std::string &value, std::string *out) {
+  out->push_back(static_cast<char>(Marker::kString));
+  WriteUtf8(value, out);
+}
+
+
+void Amf0::WriteNull(std::string *out) {
+  out->push_back(static_cast<char>(Marker::kNull));
+}
+
+
+void Amf0::WriteObject(const Object &object, std::string *out) {
+  out->push_back(static_cast<char>(Marker::kObject));
+  for (const auto &property : object) {
+    WriteUtf8(property.first, out);
+    out->append(property.second);
+  }
+  WriteUtf8("", out);
+  out->push_back(static_cast<char>(Marker::kObjectEnd));
+}
+
+
+std::string Amf0::Number(double value) {
+  std::string out;
+  WriteNumber(value, &out);
+  return out;
+}
+
+
+std::string Amf0::String(const std::string &value) {
+  std::string out;
+  WriteString(value, &out);
+  return out;
+}
+
+
+bool Amf0::ReadNumber(
+    const std::string &in, std::size_t *pos, double *value) {
+  if (in.size() < *pos + 9 ||
+      in[*pos] != static_cast<char>(Marker::kNumber)) {
+    return false;
+  }
+
+  uint64_t bits{0};
+  for (std::size_t i = 1; i <= 8; ++i) {
+    bits = (bits << 8) | static_cast<uint8_t>(in[*pos + i]);
+  }
+  std::memcpy(value, &bits, sizeof(bits));
+  *pos += 9;
+  return true;
+}
+
+
+bool Amf0::ReadString(
+    const std::string &in, std::size_t *pos, std::string *value) {
+  if (in.size() < *pos + 3 ||
+      in[*pos] != static_cast<char>(Marker::kString)) {
+    return false;
+  }
+
+  const std::size_t size =
+      (static_cast<uint8_t>(in[*pos + 1]) << 8) |
+      static_cast<uint8_t>(in[*pos + 2]);
+  if (in.size() < *pos + 3 + size) {
+    return false;
+  }
+  value->assign(in, *pos + 3, size);
+  *pos += 3 + size;
+  return true;
+}
+
+
+void Amf0::WriteUtf8(const std::string &value, std::string *out) {
+  out->push_back(static_cast<char>((value.size() >> 8) & 0xFF));
+  out->push_back(static_cast<char>(value.size() & 0xFF));
+  out->append(value);
+}
+}  // namespace start_latency_bench
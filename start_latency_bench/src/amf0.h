@@ -0,0 +1,50 @@
+/**
+* Copyright (C) 2017 NCSOFT Corporation
+*/
+
+
+#ifndef START_LATENCY_BENCH_SRC_AMF0_H_
+#define START_LATENCY_BENCH_SRC_AMF0_H_
+
+
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace start_latency_bench {
+// Just enough AMF0 for the RTMP commands a publisher sends and expects.
+class Amf0 {
+ public:
+  using Object = std::vector<std::pair<std::string, std::string>>;
+
+  static void WriteNumber(double value, std::string *out);
+  static void WriteString(const std::string &value, std::string *out);
+  static void WriteNull(std::string *out);
+  // values of the object are already encoded.
+  static void WriteObject(const Object &object, std::string *out);
+
+  static std::string Number(double value);
+  static std::string String(const std::string &value);
+
+  // both return false, leaving *pos alone, on any other type.
+  static bool ReadNumber(
+      const std::string &in, std::size_t *pos, double *value);
+  static bool ReadString(
+      const std::string &in, std::size_t *pos, std::string *value);
+
+ private:
+  enum class Marker : char {
+    kNumber = 0x00,
+    kString = 0x02,
+    kObject = 0x03,
+    kNull = 0x05,
+    kObjectEnd = 0x09,
+  };
+
+  static void WriteUtf8(const std::string &value, std::string *out);
+};
+}  // namespace start_latency_bench
+
+
+#endif  // START_LATENCY_BENCH_SRC_AMF0_H_
@@ -0,0 +1,156 @@
+/**
+* Copyright (C) 2017 NCSOFT Corporation
+*/
+
+
+#include "start_latency_bench/src/bench_runner.h"
+
+#include <sstream>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "boost/property_tree/json_parser.hpp"
+#include "boost/property_tree/ptree.hpp"
+
+#include "ncstreamer_cef/src/obs.h"
+#include "ncstreamer_cef/src/start_latency_recorder.h"
+
+
+namespace start_latency_bench {
+BenchRunner::BenchRunner(const std::string &live_video_uri, int hold_ms)
+    : live_video_uri_{live_video_uri},
+      hold_{hold_ms},
+      http_{} {
+}
+
+
+BenchRunner::~BenchRunner() {
+}
+
+
+std::string BenchRunner::RunOnce() {
+  static const std::chrono::milliseconds kStartTimeout{30000};
+
+  ncstreamer::StartLatencyRecorder *latency =
+      ncstreamer::StartLatencyRecorder::Get();
+  auto started = std::make_shared<Outcome>();
+
+  boost::property_tree::ptree post;
+  post.put("title", "start latency bench");
+  latency->Begin();
+  http_.Post(
+      live_video_uri_,
+      post,
+      [started](const boost::system::error_code &ec) {
+    started->Set("provider: " + ec.message());
+  }, [this, started](const std::string &data) {
+    std::string stream_server{};
+    std::string stream_key{};
+    try {
+      std::stringstream ss{data};
+      boost::property_tree::ptree tree;
+      boost::property_tree::read_json(ss, tree);
+      stream_server = tree.get<std::string>("stream_server");
+      stream_key = tree.get<std::string>("stream_key");
+    } catch (const std::exception &/*e*/) {
+      started->Set("provider: bad response");
+      return;
+    }
+    ncstreamer::StartLatencyRecorder::Get()->Mark(
+        ncstreamer::StartLatencyRecorder::Stage::kMockPosted);
+    StartStreaming(stream_server, stream_key, started);
+  });
+
+  std::string error{};
+  if (started->WaitFor(kStartTimeout, &error) == false) {
+    error = "start timeout";
+  }
+  latency->Finish(error);
+
+  if (error.empty() == true) {
+    std::this_thread::sleep_for(hold_);
+  }
+  StopStreaming();
+  return error;
+}
+
+
+void BenchRunner::StartStreaming(
+    const std::string &stream_server,
+    const std::string &stream_key,
+    const std::shared_ptr<Outcome> &started) {
+  // title:class:exe, as the client passes it; the headless backend ignores
+  // it and captures the synthetic source.
+  static const std::string kSourceInfo{"Start Latency Bench:bench:bench.exe"};
+  static const std::string kServiceProvider{"Twitch"};
+
+  bool result = ncstreamer::Obs::Get()->StartStreaming(
+      kSourceInfo,
+      kServiceProvider,
+      stream_server,
+      std::vector<std::string>{},
+      stream_key,
+      [started]() {
+    ncstreamer::StartLatencyRecorder::Get()->Mark(
+        ncstreamer::StartLatencyRecorder::Stage::kOutputStarted);
+    started->Set("");
+  }, [started](ncstreamer::ObsOutput::StopReason /*reason*/) {
+    started->Set("obs stopped");
+  }, [](int /*attempt*/,
+        const std::chrono::milliseconds &/*delay*/,
+        const std::string &/*stream_server*/) {
+  }, [](int /*attempts*/, const std::string &/*stream_server*/) {
+  }, [](ncstreamer::StartLatencyRecorder::Stage stage) {
+    ncstreamer::StartLatencyRecorder::Get()->Mark(stage);
+  });
+  if (result == false) {
+    started->Set("obs internal");
+  }
+}
+
+
+void BenchRunner::StopStreaming() {
+  static const std::chrono::milliseconds kStopTimeout{30000};
+
+  auto stopped = std::make_shared<Outcome>();
+  ncstreamer::Obs::Get()->StopStreaming(
+      [stopped](ncstreamer::ObsOutput::StopReason /*reason*/) {
+    stopped->Set("");
+  });
+
+  std::string error{};
+  stopped->WaitFor(kStopTimeout, &error);
+}
+
+
+BenchRunner::Outcome::Outcome()
+    : mutex_{},
+      done_{},
+      set_{false},
+      error_{} {
+}
+
+
+void BenchRunner::Outcome::Set(const std::string &error) {
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (set_ == true) {
+      return;
+    }
+    set_ = true;
+    error_ = error;
+  }
+  done_.notify_all();
+}
+
+
+bool BenchRunner::Outcome::WaitFor(
+    const std::chrono::milliseconds &timeout, std::string *error) {
+  std::unique_lock<std::mutex> lock{mutex_};
+  if (done_.wait_for(lock, timeout, [this]() { return set_; }) == false) {
+    return false;
+  }
+  *error = error_;
+  return true;
+}
+}  // namespace start_latency_bench
@@ -0,0 +1,63 @@
+/**
+* Copyright (C) 2017 NCSOFT Corporation
+*/
+
+
+#ifndef START_LATENCY_BENCH_SRC_BENCH_RUNNER_H_
+#define START_LATENCY_BENCH_SRC_BENCH_RUNNER_H_
+
+
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+
+#include "ncstreamer_cef/src/lib/http_request_service.h"
+
+
+namespace start_latency_bench {
+// Times a streaming start from Obs::StartStreaming on. StreamingService
+// is not involved: a plain POST to the mock provider stands in for the
+// live video post and is recorded as the "mock post" stage, so provider
+// latency is not measured. The stages go to the StartLatencyRecorder,
+// which must be set up.
+class BenchRunner {
+ public:
+  BenchRunner(const std::string &live_video_uri, int hold_ms);
+  virtual ~BenchRunner();
+
+  // starts, holds and stops one stream; returns the start error, if any.
+  std::string RunOnce();
+
+ private:
+  // the first result wins; callbacks may race with a stop.
+  class Outcome {
+   public:
+    Outcome();
+
+    void Set(const std::string &error);
+    bool WaitFor(
+        const std::chrono::milliseconds &timeout, std::string *error);
+
+   private:
+    std::mutex mutex_;
+    std::condition_variable done_;
+    bool set_;
+    std::string error_;
+  };
+
+  void StartStreaming(
+      const std::string &stream_server,
+      const std::string &stream_key,
+      const std::shared_ptr<Outcome> &started);
+  void StopStreaming();
+
+  const std::string live_video_uri_;
+  const std::chrono::milliseconds hold_;
+  ncstreamer::HttpRequestService http_;
+};
+}  // namespace start_latency_bench
+
+
+#endif  // START_LATENCY_BENCH_SRC_BENCH_RUNNER_H_
@@ -0,0 +1,61 @@
+/**
+* Copyright (C) 2017 NCSOFT Corporation
+*/
+
+
+#include <iostream>
+
+#include "boost/filesystem/path.hpp"
+
+#include "ncstreamer_cef/src/local_storage.h"
+#include "ncstreamer_cef/src/obs.h"
+#include "ncstreamer_cef/src/obs/obs_backend.h"
+#include "ncstreamer_cef/src/start_latency_recorder.h"
+#include "start_latency_bench/src/bench_runner.h"
+#include "start_latency_bench/src/mock_provider_server.h"
+#include "start_latency_bench/src/program_option_map.h"
+#include "start_latency_bench/src/rtmp_sink.h"
+
+
+int main(int argc, char *argv[]) {
+  start_latency_bench::ProgramOptionMap options{argc, argv};
+  if (options.failed_to_parse()) {
+    std::cout << options.description();
+    return -1;
+  }
+  if (options.help()) {
+    std::cout << options.description();
+    return 0;
+  }
+
+  // in memory, so measured encoder presets do not leak into the app's.
+  ncstreamer::LocalStorage::SetUp(L"");
+  ncstreamer::StartLatencyRecorder::SetUp(
+      boost::filesystem::path{options.output()}.wstring());
+  ncstreamer::Obs::SetUp(ncstreamer::ObsBackend::Create(L"headless"));
+
+  int failures{0};
+  {
+    start_latency_bench::RtmpSink sink{options.rtmp_port()};
+    start_latency_bench::MockProviderServer provider{
+        options.provider_port(), sink.stream_server()};
+    start_latency_bench::BenchRunner runner{
+        provider.live_video_uri(), options.hold_ms()};
+
+    for (int run = 1; run <= options.runs(); ++run) {
+      const std::string &error = runner.RunOnce();
+      std::cout << "run " << run << ": "
+                << (error.empty() ? "started" : error) << std::endl;
+      if (error.empty() == false) {
+        ++failures;
+      }
+    }
+    std::cout << "media bytes received: " << sink.media_bytes() << std::endl;
+  }
+
+  ncstreamer::Obs::ShutDown();
+  ncstreamer::StartLatencyRecorder::ShutDown();
+  ncstreamer::LocalStorage::ShutDown();
+
+  return (failures == 0) ? 0 : -1;
+}
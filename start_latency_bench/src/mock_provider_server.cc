@@ -0,0 +1,155 @@
+/**
+* Copyright (C) 2017 NCSOFT Corporation
+*/
+
+
+#include "start_latency_bench/src/mock_provider_server.h"
+
+#include <istream>
+#include <sstream>
+
+#include "boost/algorithm/string.hpp"
+#include "boost/property_tree/json_parser.hpp"
+#include "boost/property_tree/ptree.hpp"
+
+
+namespace start_latency_bench {
+class MockProviderServer::Session
+    : public std::enable_shared_from_this<Session> {
+ public:
+  Session(MockProviderServer *server, boost::asio::io_service *io_service)
+      : server_{server},
+        socket_{*io_service},
+        request_{},
+        response_{} {
+  }
+
+  boost::asio::ip::tcp::socket &socket() { return socket_; }
+
+  void Start() {
+    auto self = shared_from_this();
+    boost::asio::async_read_until(socket_, request_, "\r\n\r\n",
+        [self](const boost::system::error_code &ec,
+               std::size_t header_size) {
+      if (ec) {
+        return;
+      }
+      self->ReadBody(header_size);
+    });
+  }
+
+ private:
+  void ReadBody(std::size_t header_size) {
+    std::string header{
+        boost::asio::buffers_begin(request_.data()),
+        boost::asio::buffers_begin(request_.data()) + header_size};
+    std::size_t content_length{0};
+    std::istringstream lines{header};
+    for (std::string line; std::getline(lines, line);) {
+      static const std::string kContentLength{"content-length:"};
+      if (boost::algorithm::istarts_with(line, kContentLength) == true) {
+        content_length = std::stoul(boost::algorithm::trim_copy(
+            line.substr(kContentLength.size())));
+      }
+    }
+
+    // part of the body may have come in with the header.
+    const std::size_t buffered = request_.size() - header_size;
+    const std::size_t rest =
+        (content_length > buffered) ? content_length - buffered : 0;
+
+    auto self = shared_from_this();
+    boost::asio::async_read(socket_, request_,
+        boost::asio::transfer_exactly(rest),
+        [self](const boost::system::error_code &ec, std::size_t /*size*/) {
+      if (ec) {
+        return;
+      }
+      self->Respond(self->server_->PostLiveVideo());
+    });
+  }
+
+  void Respond(const std::string &body) {
+    std::stringstream response;
+    response << "HTTP/1.1 200 OK\r\n"
+             << "Content-Type: application/json\r\n"
+             << "Content-Length: " << body.size() << "\r\n"
+             << "Connection: close\r\n\r\n"
+             << body;
+    response_ = response.str();
+
+    auto self = shared_from_this();
+    boost::asio::async_write(socket_, boost::asio::buffer(response_),
+        [self](const boost::system::error_code &/*ec*/,
+               std::size_t /*size*/) {
+      boost::system::error_code ignored;
+      self->socket_.shutdown(
+          boost::asio::ip::tcp::socket::shutdown_both, ignored);
+    });
+  }
+
+  MockProviderServer *const server_;
+  boost::asio::ip::tcp::socket socket_;
+  boost::asio::streambuf request_;
+  std::string response_;
+};
+
+
+MockProviderServer::MockProviderServer(
+    uint16_t port, const std::string &stream_server)
+    : port_{port},
+      stream_server_{stream_server},
+      last_video_id_{0},
+      io_service_{},
+      acceptor_{io_service_, boost::asio::ip::tcp::endpoint{
+          boost::asio::ip::address_v4::loopback(), port}},
+      io_thread_{} {
+  Accept();
+  io_thread_ = std::thread{[this]() {
+    io_service_.run();
+  }};
+}
+
+
+MockProviderServer::~MockProviderServer() {
+  io_service_.stop();
+  if (io_thread_.joinable() == true) {
+    io_thread_.join();
+  }
+}
+
+
+std::string MockProviderServer::live_video_uri() const {
+  return "http://127.0.0.1:" + std::to_string(port_) + "/live_videos";
+}
+
+
+void MockProviderServer::Accept() {
+  auto session = std::make_shared<Session>(this, &io_service_);
+  acceptor_.async_accept(session->socket(),
+      [this, session](const boost::system::error_code &ec) {
+    if (ec == boost::asio::error::operation_aborted) {
+      return;
+    }
+    if (!ec) {
+      session->Start();
+    }
+    Accept();
+  });
+}
+
+
+std::string MockProviderServer::PostLiveVideo() {
+  // only touched on the io thread.
+  const std::string &video_id = std::to_string(++last_video_id_);
+
+  boost::property_tree::ptree tree;
+  tree.put("id", video_id);
+  tree.put("stream_server", stream_server_);
+  tree.put("stream_key", "bench" + video_id);
+
+  std::stringstream body;
+  boost::property_tree::write_json(body, tree, false);
+  return body.str();
+}
+}  // namespace start_latency_bench
@@ -0,0 +1,45 @@
+/**
+* Copyright (C) 2017 NCSOFT Corporation
+*/
+
+
+#ifndef START_LATENCY_BENCH_SRC_MOCK_PROVIDER_SERVER_H_
+#define START_LATENCY_BENCH_SRC_MOCK_PROVIDER_SERVER_H_
+
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+
+#include "boost/asio.hpp"
+
+
+namespace start_latency_bench {
+// Stands in for the provider's live video API on 127.0.0.1. Every POST is
+// answered with the given stream server and a fresh stream key.
+class MockProviderServer {
+ public:
+  MockProviderServer(uint16_t port, const std::string &stream_server);
+  virtual ~MockProviderServer();
+
+  std::string live_video_uri() const;
+
+ private:
+  class Session;
+
+  void Accept();
+  std::string PostLiveVideo();
+
+  const uint16_t port_;
+  const std::string stream_server_;
+  int last_video_id_;
+
+  boost::asio::io_service io_service_;
+  boost::asio::ip::tcp::acceptor acceptor_;
+  std::thread io_thread_;
+};
+}  // namespace start_latency_bench
+
+
+#endif  // START_LATENCY_BENCH_SRC_MOCK_PROVIDER_SERVER_H_
@@ -0,0 +1,104 @@
+/**
+* Copyright (C) 2017 NCSOFT Corporation
+*/
+
+
+#include "start_latency_bench/src/program_option_map.h"
+
+
+namespace start_latency_bench {
+ProgramOptionMap::ProgramOptionMap(int argc, const char *const argv[])
+    : failed_to_parse_{false},
+      description_{"Options"},
+      help_{false},
+      runs_{0},
+      hold_ms_{0},
+      output_{},
+      provider_port_{0},
+      rtmp_port_{0} {
+  description_.add_options()
+      ("help", "Help screen")
+      ("runs",
+        boost::program_options::value<int>()->default_value(10),
+        "Number of stream starts to measure")
+      ("hold-ms",
+        boost::program_options::value<int>()->default_value(2000),
+        "How long each stream stays live before it is stopped")
+      ("output",
+        boost::program_options::value<std::string>()->default_value(
+            "start_latency.json"),
+        "File the per-start JSON lines are appended to")
+      ("provider-port",
+        boost::program_options::value<uint16_t>()->default_value(18080),
+        "Port of the mock provider HTTP server")
+      ("rtmp-port",
+        boost::program_options::value<uint16_t>()->default_value(11935),
+        "Port of the local RTMP sink");
+
+  boost::program_options::variables_map vm;
+  try {
+    boost::program_options::store(
+        parse_command_line(argc, argv, description_), vm);
+  } catch (const boost::program_options::error &/*e*/) {
+    failed_to_parse_ = true;
+  }
+
+  if (failed_to_parse_ == true) {
+    return;
+  }
+
+  boost::program_options::notify(vm);
+  help_ = (vm.count("help") >= 1);
+
+  runs_ = vm["runs"].as<int>();
+  hold_ms_ = vm["hold-ms"].as<int>();
+  output_ = vm["output"].as<std::string>();
+  provider_port_ = vm["provider-port"].as<uint16_t>();
+  rtmp_port_ = vm["rtmp-port"].as<uint16_t>();
+}
+
+
+ProgramOptionMap::~ProgramOptionMap() {
+}
+
+
+bool ProgramOptionMap::failed_to_parse() const {
+  return failed_to_parse_;
+}
+
+
+const boost::program_options::options_description &
+    ProgramOptionMap::description() const {
+  return description_;
+}
+
+
+bool ProgramOptionMap::help() const {
+  return help_;
+}
+
+
+int ProgramOptionMap::runs() const {
+  return runs_;
+}
+
+
+int ProgramOptionMap::hold_ms() const {
+  return hold_ms_;
+}
+
+
+const std::string &ProgramOptionMap::output() const {
+  return output_;
+}
+
+
+uint16_t ProgramOptionMap::provider_port() const {
+  return provider_port_;
+}
+
+
+uint16_t ProgramOptionMap::rtmp_port() const {
+  return rtmp_port_;
+}
+}  // namespace start_latency_bench
@@ -0,0 +1,46 @@
+/**
+* Copyright (C) 2017 NCSOFT Corporation
+*/
+
+
+#ifndef START_LATENCY_BENCH_SRC_PROGRAM_OPTION_MAP_H_
+#define START_LATENCY_BENCH_SRC_PROGRAM_OPTION_MAP_H_
+
+
+#include <cstdint>
+#include <string>
+
+#include "boost/program_options.hpp"
+
+
+namespace start_latency_bench {
+class ProgramOptionMap {
+ public:
+  ProgramOptionMap(int argc, const char *const argv[]);
+  virtual ~ProgramOptionMap();
+
+  bool failed_to_parse() const;
+  const boost::program_options::options_description &description() const;
+  bool help() const;
+
+  int runs() const;
+  int hold_ms() const;
+  const std::string &output() const;
+  uint16_t provider_port() const;
+  uint16_t rtmp_port() const;
+
+ private:
+  bool failed_to_parse_;
+  boost::program_options::options_description description_;
+  bool help_;
+
+  int runs_;
+  int hold_ms_;
+  std::string output_;
+  uint16_t provider_port_;
+  uint16_t rtmp_port_;
+};
+}  // namespace start_latency_bench
+
+
+#endif  // START_LATENCY_BENCH_SRC_PROGRAM_OPTION_MAP_H_
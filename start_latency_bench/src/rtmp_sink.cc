@@ -0,0 +1,358 @@
+/**
+* Copyright (C) 2017 NCSOFT Corporation
+*/
+
+
+#include "start_latency_bench/src/rtmp_sink.h"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <unordered_map>
+
+#include "start_latency_bench/src/amf0.h"
+
+
+namespace start_latency_bench {
+class RtmpSink::Session
+    : public std::enable_shared_from_this<Session> {
+ public:
+  Session(RtmpSink *sink, boost::asio::io_service *io_service)
+      : sink_{sink},
+        socket_{*io_service},
+        read_buffer_{},
+        in_{},
+        stage_{Stage::kC0C1},
+        in_chunk_size_{kDefaultChunkSize},
+        chunk_streams_{},
+        out_{} {
+  }
+
+  boost::asio::ip::tcp::socket &socket() { return socket_; }
+
+  void Start() {
+    Read();
+  }
+
+ private:
+  enum class Stage {
+    kC0C1,
+    kC2,
+    kChunks,
+  };
+
+  enum class MessageType : uint8_t {
+    kSetChunkSize = 1,
+    kAudio = 8,
+    kVideo = 9,
+    kCommand = 20,
+  };
+
+  class ChunkStream {
+   public:
+    ChunkStream()
+        : length{0},
+          type{0},
+          stream_id{0},
+          extended_timestamp{false},
+          payload{} {
+    }
+
+    uint32_t length;
+    uint8_t type;
+    uint32_t stream_id;
+    bool extended_timestamp;
+    std::string payload;
+  };
+
+  static const std::size_t kHandshakeSize{1536};
+  static const std::size_t kDefaultChunkSize{128};
+  static const uint32_t kPublishStreamId{1};
+
+  static uint32_t ReadBigEndian(const std::string &in, std::size_t pos, int n) {
+    uint32_t value{0};
+    for (int i = 0; i < n; ++i) {
+      value = (value << 8) | static_cast<uint8_t>(in[pos + i]);
+    }
+    return value;
+  }
+
+  static void WriteBigEndian(uint32_t value, int n, std::string *out) {
+    for (int i = n - 1; i >= 0; --i) {
+      out->push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+  }
+
+  void Read() {
+    auto self = shared_from_this();
+    socket_.async_read_some(boost::asio::buffer(read_buffer_),
+        [self](const boost::system::error_code &ec, std::size_t size) {
+      if (ec) {
+        return;
+      }
+      self->in_.append(self->read_buffer_.data(), size);
+      self->Process();
+      self->Read();
+    });
+  }
+
+  void Process() {
+    while (true) {
+      switch (stage_) {
+      case Stage::kC0C1:
+        if (in_.size() < 1 + kHandshakeSize) {
+          return;
+        }
+        {
+          // S0, then S1 with zero time and version, then S2 echoing C1.
+          std::string s0s1s2{'\x03'};
+          s0s1s2.append(kHandshakeSize, '\0');
+          s0s1s2.append(in_, 1, kHandshakeSize);
+          Write(s0s1s2);
+        }
+        in_.erase(0, 1 + kHandshakeSize);
+        stage_ = Stage::kC2;
+        break;
+      case Stage::kC2:
+        if (in_.size() < kHandshakeSize) {
+          return;
+        }
+        in_.erase(0, kHandshakeSize);
+        stage_ = Stage::kChunks;
+        break;
+      case Stage::kChunks:
+        if (ReadChunk() == false) {
+          return;
+        }
+        break;
+      default:
+        return;
+      }
+    }
+  }
+
+  // returns false until a whole chunk is buffered.
+  bool ReadChunk() {
+    static const std::size_t kHeaderSizes[]{11, 7, 3, 0};
+
+    if (in_.size() < 1) {
+      return false;
+    }
+    const int fmt = static_cast<uint8_t>(in_[0]) >> 6;
+    uint32_t chunk_stream_id = static_cast<uint8_t>(in_[0]) & 0x3F;
+    std::size_t pos{1};
+    if (chunk_stream_id == 0) {
+      if (in_.size() < 2) {
+        return false;
+      }
+      chunk_stream_id = 64 + static_cast<uint8_t>(in_[1]);
+      pos = 2;
+    } else if (chunk_stream_id == 1) {
+      if (in_.size() < 3) {
+        return false;
+      }
+      chunk_stream_id = 64 + static_cast<uint8_t>(in_[1]) +
+                        static_cast<uint8_t>(in_[2]) * 256;
+      pos = 3;
+    }
+
+    if (in_.size() < pos + kHeaderSizes[fmt]) {
+      return false;
+    }
+    // rereading a header that is not complete yet sets the same values.
+    ChunkStream &chunk_stream = chunk_streams_[chunk_stream_id];
+    if (fmt <= 2) {
+      chunk_stream.extended_timestamp =
+          (ReadBigEndian(in_, pos, 3) == 0xFFFFFF);
+    }
+    if (fmt <= 1) {
+      chunk_stream.length = ReadBigEndian(in_, pos + 3, 3);
+      chunk_stream.type = static_cast<uint8_t>(in_[pos + 6]);
+    }
+    if (fmt == 0) {
+      // the message stream id is little endian.
+      chunk_stream.stream_id = static_cast<uint8_t>(in_[pos + 7]) |
+          (static_cast<uint8_t>(in_[pos + 8]) << 8) |
+          (static_cast<uint8_t>(in_[pos + 9]) << 16) |
+          (static_cast<uint8_t>(in_[pos + 10]) << 24);
+    }
+    pos += kHeaderSizes[fmt];
+    if (chunk_stream.extended_timestamp == true) {
+      pos += 4;
+    }
+
+    const std::size_t data_size = std::min<std::size_t>(
+        in_chunk_size_, chunk_stream.length - chunk_stream.payload.size());
+    if (in_.size() < pos + data_size) {
+      return false;
+    }
+    chunk_stream.payload.append(in_, pos, data_size);
+    in_.erase(0, pos + data_size);
+
+    if (chunk_stream.payload.size() == chunk_stream.length) {
+      OnMessage(chunk_stream.type, chunk_stream.payload);
+      chunk_stream.payload.clear();
+    }
+    return true;
+  }
+
+  void OnMessage(uint8_t type, const std::string &payload) {
+    switch (static_cast<MessageType>(type)) {
+    case MessageType::kSetChunkSize:
+      if (payload.size() >= 4) {
+        in_chunk_size_ = ReadBigEndian(payload, 0, 4) & 0x7FFFFFFF;
+      }
+      break;
+    case MessageType::kAudio:
+    case MessageType::kVideo:
+      sink_->media_bytes_ += payload.size();
+      break;
+    case MessageType::kCommand:
+      OnCommand(payload);
+      break;
+    default:
+      break;
+    }
+  }
+
+  void OnCommand(const std::string &payload) {
+    std::size_t pos{0};
+    std::string name{};
+    double transaction_id{0};
+    if (Amf0::ReadString(payload, &pos, &name) == false ||
+        Amf0::ReadNumber(payload, &pos, &transaction_id) == false) {
+      return;
+    }
+
+    std::string reply;
+    if (name == "connect") {
+      Amf0::WriteString("_result", &reply);
+      Amf0::WriteNumber(transaction_id, &reply);
+      Amf0::WriteObject({
+          {"fmsVer", Amf0::String("FMS/3,0,1,123")},
+          {"capabilities", Amf0::Number(31)}}, &reply);
+      Amf0::WriteObject({
+          {"level", Amf0::String("status")},
+          {"code", Amf0::String("NetConnection.Connect.Success")},
+          {"description", Amf0::String("Connection succeeded.")},
+          {"objectEncoding", Amf0::Number(0)}}, &reply);
+      WriteMessage(3, 0, reply);
+    } else if (name == "createStream") {
+      Amf0::WriteString("_result", &reply);
+      Amf0::WriteNumber(transaction_id, &reply);
+      Amf0::WriteNull(&reply);
+      Amf0::WriteNumber(kPublishStreamId, &reply);
+      WriteMessage(3, 0, reply);
+    } else if (name == "publish") {
+      Amf0::WriteString("onStatus", &reply);
+      Amf0::WriteNumber(0, &reply);
+      Amf0::WriteNull(&reply);
+      Amf0::WriteObject({
+          {"level", Amf0::String("status")},
+          {"code", Amf0::String("NetStream.Publish.Start")},
+          {"description", Amf0::String("Start publishing.")}}, &reply);
+      WriteMessage(5, kPublishStreamId, reply);
+    }
+  }
+
+  void WriteMessage(
+      uint8_t chunk_stream_id,
+      uint32_t stream_id,
+      const std::string &payload) {
+    std::string message;
+    message.push_back(static_cast<char>(chunk_stream_id));  // fmt 0
+    WriteBigEndian(0, 3, &message);  // timestamp
+    WriteBigEndian(static_cast<uint32_t>(payload.size()), 3, &message);
+    message.push_back(static_cast<char>(MessageType::kCommand));
+    for (int i = 0; i < 4; ++i) {
+      message.push_back(static_cast<char>((stream_id >> (i * 8)) & 0xFF));
+    }
+
+    for (std::size_t pos = 0; pos < payload.size();
+         pos += kDefaultChunkSize) {
+      if (pos > 0) {
+        message.push_back(static_cast<char>(0xC0 | chunk_stream_id));
+      }
+      message.append(payload, pos, kDefaultChunkSize);
+    }
+    Write(message);
+  }
+
+  void Write(const std::string &data) {
+    out_.emplace_back(data);
+    if (out_.size() == 1) {
+      WriteFront();
+    }
+  }
+
+  void WriteFront() {
+    auto self = shared_from_this();
+    boost::asio::async_write(socket_, boost::asio::buffer(out_.front()),
+        [self](const boost::system::error_code &ec, std::size_t /*size*/) {
+      if (ec) {
+        return;
+      }
+      self->out_.pop_front();
+      if (self->out_.empty() == false) {
+        self->WriteFront();
+      }
+    });
+  }
+
+  RtmpSink *const sink_;
+  boost::asio::ip::tcp::socket socket_;
+  std::array<char, 16 * 1024> read_buffer_;
+  std::string in_;
+  Stage stage_;
+  std::size_t in_chunk_size_;
+  std::unordered_map<uint32_t, ChunkStream> chunk_streams_;
+  std::deque<std::string> out_;
+};
+
+
+RtmpSink::RtmpSink(uint16_t port)
+    : port_{port},
+      media_bytes_{0},
+      io_service_{},
+      acceptor_{io_service_, boost::asio::ip::tcp::endpoint{
+          boost::asio::ip::address_v4::loopback(), port}},
+      io_thread_{} {
+  Accept();
+  io_thread_ = std::thread{[this]() {
+    io_service_.run();
+  }};
+}
+
+
+RtmpSink::~RtmpSink() {
+  io_service_.stop();
+  if (io_thread_.joinable() == true) {
+    io_thread_.join();
+  }
+}
+
+
+std::string RtmpSink::stream_server() const {
+  return "rtmp://127.0.0.1:" + std::to_string(port_) + "/live";
+}
+
+
+uint64_t RtmpSink::media_bytes() const {
+  return media_bytes_;
+}
+
+
+void RtmpSink::Accept() {
+  auto session = std::make_shared<Session>(this, &io_service_);
+  acceptor_.async_accept(session->socket(),
+      [this, session](const boost::system::error_code &ec) {
+    if (ec == boost::asio::error::operation_aborted) {
+      return;
+    }
+    if (!ec) {
+      session->Start();
+    }
+    Accept();
+  });
+}
+}  // namespace start_latency_bench
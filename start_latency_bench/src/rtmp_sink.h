@@ -0,0 +1,46 @@
+/**
+* Copyright (C) 2017 NCSOFT Corporation
+*/
+
+
+#ifndef START_LATENCY_BENCH_SRC_RTMP_SINK_H_
+#define START_LATENCY_BENCH_SRC_RTMP_SINK_H_
+
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+
+#include "boost/asio.hpp"
+
+
+namespace start_latency_bench {
+// A local RTMP server that takes a publish and throws the media away. It
+// answers connect, createStream and publish, which is all a publisher
+// waits for before its output counts as started.
+class RtmpSink {
+ public:
+  explicit RtmpSink(uint16_t port);
+  virtual ~RtmpSink();
+
+  std::string stream_server() const;
+  uint64_t media_bytes() const;
+
+ private:
+  class Session;
+
+  void Accept();
+
+  const uint16_t port_;
+  std::atomic<uint64_t> media_bytes_;
+
+  boost::asio::io_service io_service_;
+  boost::asio::ip::tcp::acceptor acceptor_;
+  std::thread io_thread_;
+};
+}  // namespace start_latency_bench
+
+
+#endif  // START_LATENCY_BENCH_SRC_RTMP_SINK_H_